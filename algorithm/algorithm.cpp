@@ -17,20 +17,338 @@ $o  return 1;
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
+bool dblcmp_n(const double *a, const double *b, int *out, const size_t n, const double error_rate /* = DELTA */)
+{
+$i
+    LOG_VERIFY(a   != nullptr, false);
+    LOG_VERIFY(b   != nullptr, false);
+    LOG_VERIFY(out != nullptr, false);
+
+    LOG_VERIFY(isfinite(error_rate)   , false);
+    LOG_VERIFY(dbl_is_finite_n(a, n), false);
+    LOG_VERIFY(dbl_is_finite_n(b, n), false);
+
+$   DBLCMP_N(a, b, out, n, error_rate);
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+size_t dblcmp_mismatch(const double *a, const double *b, const size_t n, const double error_rate /* = DELTA */)
+{
+$i
+    LOG_VERIFY(a != nullptr, SIZE_MAX);
+    LOG_VERIFY(b != nullptr, SIZE_MAX);
+
+    LOG_VERIFY(isfinite(error_rate)   , SIZE_MAX);
+    LOG_VERIFY(dbl_is_finite_n(a, n), SIZE_MAX);
+    LOG_VERIFY(dbl_is_finite_n(b, n), SIZE_MAX);
+
+$   size_t pos = DBLCMP_MISMATCH(a, b, n, error_rate);
+$o  return pos;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/*
+*   Проверка по битам экспоненты, без ветвлений: компилятор векторизует цикл.
+*/
+
+static bool dbl_is_finite_n(const double *arr, size_t n)
+{
+    bool is_finite = true;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint64_t bits = 0;
+        memcpy(&bits, arr + i, sizeof(double));
+
+        is_finite &= (bits & DBL_EXP_MASK) != DBL_EXP_MASK;
+    }
+
+    return is_finite;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static int dispatch_resolve()
+{
+#ifdef ALGORITHM_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        SWAP_BLOCK      = swap_block_avx2;
+        DBLCMP_N        = dblcmp_n_avx2;
+        DBLCMP_MISMATCH = dblcmp_mismatch_avx2;
+    }
+    else if (__builtin_cpu_supports("sse2"))
+    {
+        SWAP_BLOCK      = swap_block_sse2;
+        DBLCMP_N        = dblcmp_n_sse2;
+        DBLCMP_MISMATCH = dblcmp_mismatch_sse2;
+    }
+#endif
+
+    return 1;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void dblcmp_n_scalar(const double *a, const double *b, int *out, size_t n, double error_rate)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        if      (fabs(a[i] - b[i]) < error_rate) out[i] =  0;
+        else if (a[i] < b[i])                    out[i] = -1;
+        else                                     out[i] =  1;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static size_t dblcmp_mismatch_scalar(const double *a, const double *b, size_t n, double error_rate)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!(fabs(a[i] - b[i]) < error_rate)) return i;
+    }
+
+    return n;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/*
+*   SIMD-версии повторяют скалярную формулу: |a - b| получается сбросом знакового бита разности,
+*   результат сравнения собирается как (1.0 | (a < b ? знаковый бит : 0)) & ~(|a - b| < error_rate), то есть -1.0, 0.0 или 1.0,
+*   и переводится в int одной инструкцией.
+*/
+
+#ifdef ALGORITHM_X86
+
+__attribute__((target("sse2")))
+static void dblcmp_n_sse2(const double *a, const double *b, int *out, size_t n, double error_rate)
+{
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d one  = _mm_set1_pd( 1.0);
+    const __m128d eps  = _mm_set1_pd(error_rate);
+
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128d val_a = _mm_loadu_pd(a + i);
+        __m128d val_b = _mm_loadu_pd(b + i);
+
+        __m128d is_eq = _mm_cmplt_pd(_mm_andnot_pd(sign, _mm_sub_pd(val_a, val_b)), eps);
+        __m128d is_lt = _mm_cmplt_pd(val_a, val_b);
+        __m128d res   = _mm_andnot_pd(is_eq, _mm_or_pd(one, _mm_and_pd(is_lt, sign)));
+
+        _mm_storel_epi64((__m128i *) (out + i), _mm_cvtpd_epi32(res));
+    }
+
+    dblcmp_n_scalar(a + i, b + i, out + i, n - i, error_rate);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void dblcmp_n_avx2(const double *a, const double *b, int *out, size_t n, double error_rate)
+{
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d one  = _mm256_set1_pd( 1.0);
+    const __m256d eps  = _mm256_set1_pd(error_rate);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d val_a = _mm256_loadu_pd(a + i);
+        __m256d val_b = _mm256_loadu_pd(b + i);
+
+        __m256d is_eq = _mm256_cmp_pd(_mm256_andnot_pd(sign, _mm256_sub_pd(val_a, val_b)), eps, _CMP_LT_OQ);
+        __m256d is_lt = _mm256_cmp_pd(val_a, val_b, _CMP_LT_OQ);
+        __m256d res   = _mm256_andnot_pd(is_eq, _mm256_or_pd(one, _mm256_and_pd(is_lt, sign)));
+
+        _mm_storeu_si128((__m128i *) (out + i), _mm256_cvtpd_epi32(res));
+    }
+
+    dblcmp_n_scalar(a + i, b + i, out + i, n - i, error_rate);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+__attribute__((target("sse2")))
+static size_t dblcmp_mismatch_sse2(const double *a, const double *b, size_t n, double error_rate)
+{
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d eps  = _mm_set1_pd(error_rate);
+
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128d diff = _mm_andnot_pd(sign, _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        int     mask = _mm_movemask_pd(_mm_cmpnlt_pd(diff, eps));
+
+        if (mask != 0) return i + (size_t) __builtin_ctz((unsigned) mask);
+    }
+
+    return i + dblcmp_mismatch_scalar(a + i, b + i, n - i, error_rate);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static size_t dblcmp_mismatch_avx2(const double *a, const double *b, size_t n, double error_rate)
+{
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d eps  = _mm256_set1_pd(error_rate);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256d diff_0 = _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_loadu_pd(a + i    ), _mm256_loadu_pd(b + i    )));
+        __m256d diff_1 = _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(diff_0, eps, _CMP_NLT_UQ))
+                | (_mm256_movemask_pd(_mm256_cmp_pd(diff_1, eps, _CMP_NLT_UQ)) << 4);
+
+        if (mask != 0) return i + (size_t) __builtin_ctz((unsigned) mask);
+    }
+
+    return i + dblcmp_mismatch_scalar(a + i, b + i, n - i, error_rate);
+}
+
+#endif // ALGORITHM_X86
+
+//--------------------------------------------------------------------------------------------------------------------------------
+// swap
+//--------------------------------------------------------------------------------------------------------------------------------
+
 void my_swap(void *a, void *b, size_t elem_size)
 {
 $i
     LOG_VERIFY(a != nullptr, (void) 0);
     LOG_VERIFY(b != nullptr, (void) 0);
 
-    for (; elem_size > 0; elem_size--)
+    switch (elem_size)
     {
-        char temp   = *(char *) a;
-        *(char *) a = *(char *) b;
-        *(char *) b =        temp;
+        case  1: swap_1 (a, b); break;
+        case  2: swap_2 (a, b); break;
+        case  4: swap_4 (a, b); break;
+        case  8: swap_8 (a, b); break;
+        case 16: swap_16(a, b); break;
 
-        a = (char *) a + 1;
-        b = (char *) b + 1;
+        default:
+            if (elem_size < SWAP_BLOCK_MIN_SIZE) swap_words(a, b, elem_size);
+            else                                 SWAP_BLOCK(a, b, elem_size);
+            break;
     }
 $o
 }
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/*
+*   Обмены фиксированного размера копируют элементы через memcpy во временные переменные нужной ширины:
+*   компилятор сворачивает такой memcpy в одну невыровненную загрузку/запись регистра.
+*/
+
+#define SWAP_FIXED(type)                \
+    type temp_a, temp_b;                \
+    memcpy(&temp_a, a, sizeof(type)); \
+    memcpy(&temp_b, b, sizeof(type)); \
+    memcpy(a, &temp_b, sizeof(type)); \
+    memcpy(b, &temp_a, sizeof(type));
+
+static inline void swap_1 (void *a, void *b) { SWAP_FIXED(uint8_t ) }
+static inline void swap_2 (void *a, void *b) { SWAP_FIXED(uint16_t) }
+static inline void swap_4 (void *a, void *b) { SWAP_FIXED(uint32_t) }
+static inline void swap_8 (void *a, void *b) { SWAP_FIXED(uint64_t) }
+static inline void swap_16(void *a, void *b) { SWAP_FIXED(uint128_pair) }
+
+#undef SWAP_FIXED
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static inline void swap_words(void *a, void *b, size_t elem_size)
+{
+    char *pos_a = (char *) a;
+    char *pos_b = (char *) b;
+
+    for (; elem_size >= 8; elem_size -= 8) { swap_8(pos_a, pos_b); pos_a += 8; pos_b += 8; }
+
+    if (elem_size >= 4) { swap_4(pos_a, pos_b); pos_a += 4; pos_b += 4; elem_size -= 4; }
+    if (elem_size >= 2) { swap_2(pos_a, pos_b); pos_a += 2; pos_b += 2; elem_size -= 2; }
+    if (elem_size >= 1) { swap_1(pos_a, pos_b); }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void swap_block_words(void *a, void *b, size_t elem_size)
+{
+    swap_words(a, b, elem_size);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef ALGORITHM_X86
+
+__attribute__((target("sse2")))
+static void swap_block_sse2(void *a, void *b, size_t elem_size)
+{
+    char *pos_a = (char *) a;
+    char *pos_b = (char *) b;
+
+    for (; elem_size >= 16; elem_size -= 16)
+    {
+        __m128i temp_a = _mm_loadu_si128((const __m128i *) pos_a);
+        __m128i temp_b = _mm_loadu_si128((const __m128i *) pos_b);
+
+        _mm_storeu_si128((__m128i *) pos_a, temp_b);
+        _mm_storeu_si128((__m128i *) pos_b, temp_a);
+
+        pos_a += 16;
+        pos_b += 16;
+    }
+
+    swap_words(pos_a, pos_b, elem_size);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void swap_block_avx2(void *a, void *b, size_t elem_size)
+{
+    char *pos_a = (char *) a;
+    char *pos_b = (char *) b;
+
+    for (; elem_size >= 64; elem_size -= 64)
+    {
+        __m256i temp_a_0 = _mm256_loadu_si256((const __m256i *)  pos_a);
+        __m256i temp_a_1 = _mm256_loadu_si256((const __m256i *) (pos_a + 32));
+        __m256i temp_b_0 = _mm256_loadu_si256((const __m256i *)  pos_b);
+        __m256i temp_b_1 = _mm256_loadu_si256((const __m256i *) (pos_b + 32));
+
+        _mm256_storeu_si256((__m256i *)  pos_a      , temp_b_0);
+        _mm256_storeu_si256((__m256i *) (pos_a + 32), temp_b_1);
+        _mm256_storeu_si256((__m256i *)  pos_b      , temp_a_0);
+        _mm256_storeu_si256((__m256i *) (pos_b + 32), temp_a_1);
+
+        pos_a += 64;
+        pos_b += 64;
+    }
+
+    if (elem_size >= 32)
+    {
+        __m256i temp_a = _mm256_loadu_si256((const __m256i *) pos_a);
+        __m256i temp_b = _mm256_loadu_si256((const __m256i *) pos_b);
+
+        _mm256_storeu_si256((__m256i *) pos_a, temp_b);
+        _mm256_storeu_si256((__m256i *) pos_b, temp_a);
+
+        pos_a += 32;
+        pos_b += 32;
+        elem_size -= 32;
+    }
+
+    swap_words(pos_a, pos_b, elem_size);
+}
+
+#endif // ALGORITHM_X86
@@ -3,6 +3,13 @@
 #define ALGORITHM_STATIC_H
 
 #include <math.h>
+#include <string.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ALGORITHM_X86
+#endif
 
 #include "log.h"
 #include "algorithm.h"
@@ -11,4 +18,86 @@
 
 const double DELTA = 0.0001;
 
+//================================================================================================================================
+
+/**
+*   @brief Тип функции обмена блоков памяти произвольного размера.
+*/
+typedef void (*swap_block_t) (void *a, void *b, size_t elem_size);
+
+/**
+*   @brief 16-байтовое слово для обмена элементов размера 16.
+*/
+struct uint128_pair
+{
+    uint64_t lo;
+    uint64_t hi;
+};
+
+/**
+*   @brief Тип функции поэлементного сравнения массивов вещественных чисел.
+*/
+typedef void   (*dblcmp_n_t)        (const double *a, const double *b, int *out, size_t n, double error_rate);
+
+/**
+*   @brief Тип функции поиска первой неравной пары элементов массивов вещественных чисел.
+*/
+typedef size_t (*dblcmp_mismatch_t) (const double *a, const double *b, size_t n, double error_rate);
+
+static const uint64_t DBL_EXP_MASK = 0x7FF0000000000000UL; ///< маска экспоненты double: все единицы у inf и nan
+
+static const size_t SWAP_BLOCK_MIN_SIZE = 32;  ///< минимальный размер элемента (в байтах), начиная с которого используется SIMD-обмен
+
+//================================================================================================================================
+
+static bool        dbl_is_finite_n(const double *arr, size_t n);
+
+static int         dispatch_resolve();
+
+static void        dblcmp_n_scalar       (const double *a, const double *b, int *out, size_t n, double error_rate);
+static size_t      dblcmp_mismatch_scalar(const double *a, const double *b, size_t n, double error_rate);
+
+#ifdef ALGORITHM_X86
+static void        dblcmp_n_sse2       (const double *a, const double *b, int *out, size_t n, double error_rate);
+static void        dblcmp_n_avx2       (const double *a, const double *b, int *out, size_t n, double error_rate) __attribute__((target("avx2")));
+static size_t      dblcmp_mismatch_sse2(const double *a, const double *b,           size_t n, double error_rate);
+static size_t      dblcmp_mismatch_avx2(const double *a, const double *b,           size_t n, double error_rate) __attribute__((target("avx2")));
+#endif
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static inline void swap_1    (void *a, void *b);
+static inline void swap_2    (void *a, void *b);
+static inline void swap_4    (void *a, void *b);
+static inline void swap_8    (void *a, void *b);
+static inline void swap_16   (void *a, void *b);
+static inline void swap_words(void *a, void *b, size_t elem_size);
+
+static void        swap_block_words  (void *a, void *b, size_t elem_size);
+
+#ifdef ALGORITHM_X86
+static void        swap_block_sse2   (void *a, void *b, size_t elem_size);
+static void        swap_block_avx2   (void *a, void *b, size_t elem_size) __attribute__((target("avx2")));
+#endif
+
+//================================================================================================================================
+
+/**
+*   @brief Функция обмена больших блоков памяти.
+*   Изначально указывает на переносимую реализацию, при загрузке программы dispatch_resolve() выбирает реализацию по возможностям процессора.
+*/
+static swap_block_t SWAP_BLOCK = swap_block_words;
+
+/**
+*   @brief Функции сравнения массивов вещественных чисел.
+*   Изначально указывают на скалярные реализации, при загрузке программы dispatch_resolve() выбирает реализации по возможностям процессора.
+*/
+static dblcmp_n_t        DBLCMP_N        = dblcmp_n_scalar;
+static dblcmp_mismatch_t DBLCMP_MISMATCH = dblcmp_mismatch_scalar;
+
+/**
+*   @brief Указатели выше записываются только здесь, до запуска main(), поэтому вызовы из разных потоков их лишь читают.
+*/
+static int RESOLVE_DISPATCH = dispatch_resolve();
+
 #endif // ALGORITHM_STATIC_H
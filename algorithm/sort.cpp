@@ -0,0 +1,675 @@
+#include "sort_static.h"
+
+//================================================================================================================================
+
+bool my_sort(void *base, const size_t n, const size_t el_size, int (*el_cmp)(const void *el_1, const void *el_2))
+{
+$i
+    LOG_VERIFY(base   != nullptr, false);
+    LOG_VERIFY(el_cmp != nullptr, false);
+    LOG_VERIFY(el_size > 0UL    , false);
+
+    if (n < 2) { $o return true; }
+
+    char  temp_local[SORT_TEMP_SIZE] = {};
+    char *temp = temp_local;
+
+    if (el_size > SORT_TEMP_SIZE)
+    {
+$       temp = (char *) LOG_CALLOC(1, el_size);
+        if (temp == nullptr)
+        {
+$           LOG_ERROR("log_calloc(1, el_size = %lu) returns nullptr\n", el_size);
+$o          return false;
+        }
+    }
+
+$   sort_serial((char *) base, n, el_size, el_cmp, temp);
+
+    if (temp != temp_local) LOG_FREE(temp);
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void sort_serial(char *begin, size_t n, size_t el_size, int (*el_cmp)(const void *el_1, const void *el_2), char *temp)
+{
+    size_t depth_limit = sort_depth_limit(n);
+
+    switch (el_size)
+    {
+        case 4:  sort_intro(sort_fixed<uint32_t>    (), begin, n, el_cmp, temp, depth_limit, true); break;
+        case 8:  sort_intro(sort_fixed<uint64_t>    (), begin, n, el_cmp, temp, depth_limit, true); break;
+        case 16: sort_intro(sort_fixed<sort_word_16>(), begin, n, el_cmp, temp, depth_limit, true); break;
+        default: sort_intro(sort_dynamic {el_size}    , begin, n, el_cmp, temp, depth_limit, true); break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+// parallel sort
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/*
+*   Массив рекурсивно делится на две части по числу потоков, части сортируются в разных потоках и сливаются на месте.
+*   Слияние тоже делится между потоками: точка разреза выхода (sort_co_rank()) делит левый и правый участки на L1 L2 и R1 R2,
+*   поворот ставит R1 перед L2, после чего пары (L1, R1) и (L2, R2) сливаются независимо.
+*
+*   Каждому потоку выделяется буфер на SORT_PARALLEL_BUFFER_SIZE байт (но не меньше одного элемента). Пара, один из участков которой
+*   помещается в буфер, сливается через него за один проход, иначе она делится пополам тем же разрезом с поворотом.
+*   Поэтому дополнительная память не зависит от n.
+*
+*   Из потоков не вызываются функции логов: трассировка и счетчик динамической памяти не потокобезопасны.
+*/
+
+bool my_parallel_sort(void *base, const size_t n, const size_t el_size, int (*el_cmp)(const void *el_1, const void *el_2),
+                      const size_t thread_count /* = 0 */)
+{
+$i
+    LOG_VERIFY(base   != nullptr, false);
+    LOG_VERIFY(el_cmp != nullptr, false);
+    LOG_VERIFY(el_size > 0UL    , false);
+
+$   const size_t threads = sort_thread_count(n, thread_count);
+    if (threads < 2)
+    {
+$       bool ret = my_sort(base, n, el_size, el_cmp);
+$o      return ret;
+    }
+
+    size_t buffer_n = SORT_PARALLEL_BUFFER_SIZE / el_size;
+    if (buffer_n == 0) buffer_n = 1;
+
+$   char *buffer = (char *) LOG_CALLOC(threads * buffer_n, el_size);
+    if (buffer == nullptr)
+    {
+$       bool ret = my_sort(base, n, el_size, el_cmp);
+$o      return ret;
+    }
+
+    const sort_task task = { .begin    = (char *) base,
+                             .left_n   = n,
+                             .buffer   = buffer,
+                             .buffer_n = buffer_n,
+                             .threads  = threads,
+                             .el_size  = el_size,
+                             .el_cmp   = el_cmp };
+$   sort_task_sort(&task);
+
+$   LOG_FREE(buffer);
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static size_t sort_thread_count(size_t n, size_t thread_count)
+{
+    if (thread_count == 0)
+    {
+        long cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count   = (cpu_count > 0) ? (size_t) cpu_count : 1;
+    }
+
+    if (thread_count > SORT_PARALLEL_MAX_THREADS)   thread_count = SORT_PARALLEL_MAX_THREADS;
+    if (thread_count > n / SORT_PARALLEL_MIN_CHUNK) thread_count = n / SORT_PARALLEL_MIN_CHUNK;
+
+    return thread_count;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Делит задание на два: первому достаются threads / 2 потоков и их буферы, второму - остальные.
+*
+*   @param task   [in]  - задание
+*   @param parts  [out] - массив из двух заданий
+*   @param left_n [in]  - количество элементов левого участка первого задания
+*   @param out_n  [in]  - количество элементов первого задания
+*/
+static void sort_task_split(const sort_task *const task, sort_task *parts, size_t left_n, size_t out_n)
+{
+    const size_t left_threads = task->threads / 2;
+    const size_t right_n      = out_n - left_n;
+
+    parts[0] = parts[1] = *task;
+
+    parts[0].left_n  = left_n;
+    parts[0].right_n = right_n;
+    parts[0].threads = left_threads;
+
+    parts[1].begin   = task->begin  + out_n * task->el_size;
+    parts[1].left_n  = task->left_n - left_n;
+    parts[1].right_n = task->right_n - right_n;
+    parts[1].buffer  = task->buffer + left_threads * task->buffer_n * task->el_size;
+    parts[1].threads = task->threads - left_threads;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Точка разреза слияния: сколько элементов левого участка попадает в первые out_n элементов результата.
+*   При равенстве первым идет элемент левого участка, как и в sort_merge().
+*/
+static size_t sort_co_rank(const char *left, size_t left_n, const char *right, size_t right_n, size_t out_n, size_t el_size,
+                           int (*el_cmp)(const void *el_1, const void *el_2))
+{
+    size_t lo = (out_n > right_n) ? out_n - right_n : 0;
+    size_t hi = (out_n < left_n ) ? out_n           : left_n;
+
+    while (lo < hi)
+    {
+        size_t left_cnt  = lo + (hi - lo) / 2;
+        size_t right_cnt = out_n - left_cnt;
+
+        if (el_cmp(left + left_cnt * el_size, right + (right_cnt - 1) * el_size) <= 0) lo = left_cnt + 1;
+        else                                                                          hi = left_cnt;
+    }
+
+    return lo;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Выполняет задания параллельно: первое - в текущем потоке, остальные - в новых.
+*   Если поток создать не удалось, задание выполняется в текущем потоке.
+*/
+static void sort_run_tasks(sort_task *tasks, pthread_t *threads, size_t task_count, void (*run) (const sort_task *const task))
+{
+    for (size_t task = 0; task < task_count; ++task) tasks[task].run = run;
+
+    for (size_t task = 1; task < task_count; ++task)
+    {
+        tasks[task].is_spawned = (pthread_create(threads + task, nullptr, sort_task_thread, tasks + task) == 0);
+    }
+
+    run(tasks);
+
+    for (size_t task = 1; task < task_count; ++task)
+    {
+        if (tasks[task].is_spawned) pthread_join(threads[task], nullptr);
+        else                        run(tasks + task);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void *sort_task_thread(void *task)
+{
+    const sort_task *const cur_task = (const sort_task *) task;
+    cur_task->run(cur_task);
+
+    return nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Сортирует участок [begin, begin + left_n) в task->threads потоков: части сортируются параллельно и сливаются на месте.
+*/
+static void sort_task_sort(const sort_task *const task)
+{
+    if (task->threads == 1)
+    {
+        sort_serial(task->begin, task->left_n, task->el_size, task->el_cmp, task->buffer);
+        return;
+    }
+
+    sort_task parts  [2] = {};
+    pthread_t workers[2] = {};
+
+    const size_t left_n = task->left_n * (task->threads / 2) / task->threads;
+
+    sort_task_split(task, parts, left_n, left_n);
+    sort_run_tasks (parts, workers, 2, sort_task_sort);
+
+    sort_task merge = *task;
+    merge.left_n    = left_n;
+    merge.right_n   = task->left_n - left_n;
+
+    sort_task_merge(&merge);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void sort_task_merge(const sort_task *const task)
+{
+    switch (task->el_size)
+    {
+        case 4:  sort_merge_parallel(sort_fixed<uint32_t>    ()      , task); break;
+        case 8:  sort_merge_parallel(sort_fixed<uint64_t>    ()      , task); break;
+        case 16: sort_merge_parallel(sort_fixed<sort_word_16>()      , task); break;
+        default: sort_merge_parallel(sort_dynamic {task->el_size}    , task); break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Сливает на месте участки [begin, begin + left_n) и [begin + left_n, begin + left_n + right_n) в task->threads потоков.
+*/
+template <typename elem_t>
+static void sort_merge_parallel(const elem_t elem, const sort_task *const task)
+{
+    if (task->threads == 1)
+    {
+        sort_merge_inplace(elem, task->begin, task->left_n, task->right_n, task->buffer, task->buffer_n, task->el_cmp);
+        return;
+    }
+
+    sort_task parts  [2] = {};
+    pthread_t workers[2] = {};
+
+    const size_t out_n  = (task->left_n + task->right_n) * (task->threads / 2) / task->threads;
+    const size_t left_n = sort_split(elem, task->begin, task->left_n, task->right_n, out_n, task->buffer, task->buffer_n, task->el_cmp);
+
+    sort_task_split(task, parts, left_n, out_n);
+    sort_run_tasks (parts, workers, 2, sort_task_merge);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Сливает на месте участки [begin, begin + left_n) и [begin + left_n, begin + left_n + right_n) в текущем потоке.
+*   Меньший участок, если он помещается в буфер, копируется туда и сливается с другим за один проход.
+*   Иначе пара делится пополам разрезом с поворотом (sort_split()).
+*/
+template <typename elem_t>
+static void sort_merge_inplace(const elem_t elem, char *begin, size_t left_n, size_t right_n, char *buffer, size_t buffer_n,
+                               int (*el_cmp)(const void *el_1, const void *el_2))
+{
+    const size_t el_size = elem.size();
+
+    while (left_n > 0 && right_n > 0)
+    {
+        char *right = begin + left_n * el_size;
+        if (el_cmp(right - el_size, right) <= 0) return;
+
+        if (left_n <= right_n && left_n <= buffer_n)
+        {
+            memcpy(buffer, begin, left_n * el_size);
+            sort_merge(elem, buffer, left_n, right, right_n, begin, el_cmp);
+            return;
+        }
+        if (right_n <= buffer_n)
+        {
+            memcpy(buffer, right, right_n * el_size);
+            sort_merge_back(elem, begin, left_n, buffer, right_n, el_cmp);
+            return;
+        }
+
+        const size_t out_n    = (left_n + right_n) / 2;
+        const size_t left_cnt = sort_split(elem, begin, left_n, right_n, out_n, buffer, buffer_n, el_cmp);
+
+        sort_merge_inplace(elem, begin, left_cnt, out_n - left_cnt, buffer, buffer_n, el_cmp);
+
+        begin   += out_n * el_size;
+        left_n  -= left_cnt;
+        right_n -= out_n - left_cnt;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Переставляет соседние участки L1 L2 | R1 R2 в L1 R1 | L2 R2 так, что L1 R1 - ровно первые out_n элементов результата слияния.
+*
+*   @return количество элементов в L1.
+*/
+template <typename elem_t>
+static size_t sort_split(const elem_t elem, char *begin, size_t left_n, size_t right_n, size_t out_n, char *buffer, size_t buffer_n,
+                         int (*el_cmp)(const void *el_1, const void *el_2))
+{
+    const size_t el_size  = elem.size();
+    const size_t left_cnt = sort_co_rank(begin, left_n, begin + left_n * el_size, right_n, out_n, el_size, el_cmp);
+
+    sort_rotate(elem, begin + left_cnt * el_size, left_n - left_cnt, out_n - left_cnt, buffer, buffer_n);
+    return left_cnt;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Меняет местами соседние участки [begin, begin + left_n) и [begin + left_n, begin + left_n + right_n).
+*   Пока меньший участок не помещается в буфер, он поэлементно обменивается с краем большего (алгоритм Гриса-Миллса),
+*   затем остаток переставляется через буфер.
+*/
+template <typename elem_t>
+static void sort_rotate(const elem_t elem, char *begin, size_t left_n, size_t right_n, char *buffer, size_t buffer_n)
+{
+    const size_t el_size = elem.size();
+
+    while (left_n > 0 && right_n > 0)
+    {
+        char *right = begin + left_n * el_size;
+
+        if (left_n <= right_n)
+        {
+            if (left_n <= buffer_n)
+            {
+                memcpy (buffer                   , begin , left_n  * el_size);
+                memmove(begin                    , right , right_n * el_size);
+                memcpy (begin + right_n * el_size, buffer, left_n  * el_size);
+                return;
+            }
+
+            // L R1 R2 -> R1 L R2
+            for (size_t i = 0; i < left_n; ++i) elem.swap(begin + i * el_size, right + i * el_size);
+
+            begin   += left_n * el_size;
+            right_n -= left_n;
+        }
+        else
+        {
+            if (right_n <= buffer_n)
+            {
+                memcpy (buffer                   , right , right_n * el_size);
+                memmove(begin + right_n * el_size, begin , left_n  * el_size);
+                memcpy (begin                    , buffer, right_n * el_size);
+                return;
+            }
+
+            // L1 L2 R -> L1 R L2
+            char *left = right - right_n * el_size;
+            for (size_t i = 0; i < right_n; ++i) elem.swap(left + i * el_size, right + i * el_size);
+
+            left_n -= right_n;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Сливает участки left и right в dst от начала.
+*   dst может совпадать с началом пары, если left - ее копия в буфере: тогда остаток правого участка уже на месте.
+*/
+template <typename elem_t>
+static void sort_merge(const elem_t elem, const char *left, size_t left_n, const char *right, size_t right_n, char *dst,
+                       int (*el_cmp)(const void *el_1, const void *el_2))
+{
+    const size_t el_size   = elem.size();
+    const char  *left_end  = left  + left_n  * el_size;
+    const char  *right_end = right + right_n * el_size;
+
+    while (left < left_end && right < right_end)
+    {
+        if (el_cmp(right, left) < 0) { elem.copy(dst, right); right += el_size; }
+        else                         { elem.copy(dst, left ); left  += el_size; }
+
+        dst += el_size;
+    }
+
+    memcpy(dst, left, (size_t) (left_end - left));
+    dst += left_end - left;
+
+    if (dst != right) memcpy(dst, right, (size_t) (right_end - right));
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Сливает участок [left, left + left_n) с копией следующего за ним участка из right_n элементов, лежащей в буфере right.
+*   Результат записывается с конца на место пары, остаток левого участка уже на месте.
+*/
+template <typename elem_t>
+static void sort_merge_back(const elem_t elem, char *left, size_t left_n, const char *right, size_t right_n,
+                            int (*el_cmp)(const void *el_1, const void *el_2))
+{
+    const size_t el_size   = elem.size();
+    char        *left_cur  = left  + left_n  * el_size;
+    const char  *right_cur = right + right_n * el_size;
+    char        *dst       = left_cur + right_n * el_size;
+
+    while (left_cur > left && right_cur > right)
+    {
+        dst -= el_size;
+
+        if (el_cmp(right_cur - el_size, left_cur - el_size) < 0) { left_cur  -= el_size; elem.copy(dst, left_cur ); }
+        else                                                     { right_cur -= el_size; elem.copy(dst, right_cur); }
+    }
+
+    memcpy(left_cur, right, (size_t) (right_cur - right));
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static size_t sort_depth_limit(size_t n)
+{
+    size_t depth = 0;
+    for (; n > 1; n >>= 1) depth++;
+
+    return 2 * depth;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/*
+*   Introsort в духе pdqsort: быстрая сортировка с разбиением Хоара и опорным элементом-медианой,
+*   досортировка коротких участков вставками и переход к пирамидальной сортировке при слишком глубокой рекурсии.
+*
+*   Два дополнительных случая:
+*   - если опорный элемент равен элементу перед участком, весь участок не меньше его, и равные элементы отделяются за один проход;
+*   - если разбиение не сделало ни одного обмена, участок, скорее всего, уже упорядочен, и его пробуют досортировать вставками
+*     с ограниченным числом перемещений.
+*
+*   Рекурсия идет только в меньшую часть, поэтому глубина стека не превосходит log2(n).
+*/
+
+template <typename elem_t>
+static void sort_intro(const elem_t elem, char *begin, size_t n, int (*el_cmp)(const void *el_1, const void *el_2), char *temp, size_t depth_limit, bool leftmost)
+{
+    const size_t el_size = elem.size();
+
+    while (n > SORT_INSERTION_THRESHOLD)
+    {
+        if (depth_limit == 0)
+        {
+            sort_heap(elem, begin, n, el_cmp);
+            return;
+        }
+        depth_limit--;
+
+        sort_pivot(elem, begin, n, el_cmp);
+
+        if (!leftmost && el_cmp(begin - el_size, begin) == 0)
+        {
+            size_t mid = sort_partition_left(elem, begin, n, el_cmp);
+
+            begin += (mid + 1) * el_size;
+            n     -=  mid + 1;
+            continue;
+        }
+
+        bool   was_partitioned = false;
+        size_t mid = sort_partition(elem, begin, n, el_cmp, &was_partitioned);
+
+        char  *right   = begin + (mid + 1) * el_size;
+        size_t right_n = n - mid - 1;
+
+        if (was_partitioned && sort_insertion(elem, begin, mid    , el_cmp, temp, SORT_PARTIAL_LIMIT)
+                            && sort_insertion(elem, right, right_n, el_cmp, temp, SORT_PARTIAL_LIMIT)) return;
+
+        if (mid < right_n) { sort_intro(elem, begin, mid    , el_cmp, temp, depth_limit, leftmost); begin = right; n = right_n; leftmost = false; }
+        else               { sort_intro(elem, right, right_n, el_cmp, temp, depth_limit, false   );                n = mid;                      }
+    }
+
+    sort_insertion(elem, begin, n, el_cmp, temp, SIZE_MAX);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/*
+*   Сортировка вставками. Прекращает работу и возвращает false, если суммарное число перемещений элементов превысило move_limit.
+*/
+
+template <typename elem_t>
+static bool sort_insertion(const elem_t elem, char *begin, size_t n, int (*el_cmp)(const void *el_1, const void *el_2), char *temp, size_t move_limit)
+{
+    const size_t el_size = elem.size();
+    char *const  end     = begin + n * el_size;
+    size_t       moves   = 0;
+
+    for (char *cur = begin + el_size; cur < end; cur += el_size)
+    {
+        if (el_cmp(cur - el_size, cur) <= 0) continue;
+
+        elem.copy(temp, cur);
+
+        char *hole = cur;
+        do
+        {
+            elem.copy(hole, hole - el_size);
+            hole -= el_size;
+        }
+        while (hole != begin && el_cmp(hole - el_size, temp) > 0);
+
+        elem.copy(hole, temp);
+
+        moves += (size_t) (cur - hole) / el_size;
+        if (moves > move_limit) return false;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+template <typename elem_t>
+static void sort_heap(const elem_t elem, char *begin, size_t n, int (*el_cmp)(const void *el_1, const void *el_2))
+{
+    const size_t el_size = elem.size();
+
+    for (size_t root = n / 2; root > 0; --root) sort_sift_down(elem, begin, n, root - 1, el_cmp);
+
+    for (size_t last = n - 1; last > 0; --last)
+    {
+        elem.swap(begin, begin + last * el_size);
+        sort_sift_down(elem, begin, last, 0, el_cmp);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+template <typename elem_t>
+static void sort_sift_down(const elem_t elem, char *begin, size_t n, size_t root, int (*el_cmp)(const void *el_1, const void *el_2))
+{
+    const size_t el_size = elem.size();
+
+    for (size_t child = 2 * root + 1; child < n; child = 2 * root + 1)
+    {
+        char *child_el = begin + child * el_size;
+
+        if (child + 1 < n && el_cmp(child_el, child_el + el_size) < 0) { child++; child_el += el_size; }
+
+        char *root_el = begin + root * el_size;
+        if (el_cmp(root_el, child_el) >= 0) return;
+
+        elem.swap(root_el, child_el);
+        root = child;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+template <typename elem_t>
+static void sort_3(const elem_t elem, char *a, char *b, char *c, int (*el_cmp)(const void *el_1, const void *el_2))
+{
+    if (el_cmp(b, a) < 0) elem.swap(a, b);
+    if (el_cmp(c, b) < 0)
+    {
+        elem.swap(b, c);
+        if (el_cmp(b, a) < 0) elem.swap(a, b);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+template <typename elem_t>
+static void sort_pivot(const elem_t elem, char *begin, size_t n, int (*el_cmp)(const void *el_1, const void *el_2))
+{
+    const size_t el_size = elem.size();
+
+    char *first  = begin;
+    char *middle = begin + (n / 2) * el_size;
+    char *last   = begin + (n - 1) * el_size;
+
+    if (n >= SORT_NINTHER_THRESHOLD)
+    {
+        const size_t step = (n / 8) * el_size;
+
+        sort_3(elem, first + step, first + 2 * step, first + 3 * step, el_cmp);
+        sort_3(elem, middle - step, middle         , middle + step   , el_cmp);
+        sort_3(elem, last - 3 * step, last - 2 * step, last - step   , el_cmp);
+
+        sort_3(elem, first + 2 * step, middle, last - 2 * step, el_cmp);
+    }
+    else sort_3(elem, first, middle, last, el_cmp);
+
+    elem.swap(first, middle);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/*
+*   Опорный элемент лежит в начале участка. Сканирование останавливается на равных опорному элементах,
+*   поэтому участки из одинаковых ключей делятся пополам, а не вырождаются.
+*/
+
+template <typename elem_t>
+static size_t sort_partition(const elem_t elem, char *begin, size_t n, int (*el_cmp)(const void *el_1, const void *el_2), bool *const was_partitioned)
+{
+    const size_t el_size = elem.size();
+
+    char *left  = begin + el_size;
+    char *right = begin + (n - 1) * el_size;
+
+    *was_partitioned = true;
+
+    while (true)
+    {
+        while (left <= right && el_cmp(left , begin) < 0) left  += el_size;
+        while (left <= right && el_cmp(right, begin) > 0) right -= el_size;
+
+        if (left >= right) break;
+
+        elem.swap(left, right);
+        left  += el_size;
+        right -= el_size;
+
+        *was_partitioned = false;
+    }
+
+    elem.swap(begin, right);
+    return (size_t) (right - begin) / el_size;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/*
+*   Разбиение, при котором равные опорному элементы уходят влево.
+*   Используется, когда опорный элемент равен элементу перед участком: тогда левая часть целиком состоит из равных ему элементов.
+*/
+
+template <typename elem_t>
+static size_t sort_partition_left(const elem_t elem, char *begin, size_t n, int (*el_cmp)(const void *el_1, const void *el_2))
+{
+    const size_t el_size = elem.size();
+
+    char *left  = begin + el_size;
+    char *right = begin + (n - 1) * el_size;
+
+    while (true)
+    {
+        while (left <= right && el_cmp(begin, right) <  0) right -= el_size;
+        while (left <= right && el_cmp(begin, left ) >= 0) left  += el_size;
+
+        if (left >= right) break;
+
+        elem.swap(left, right);
+        left  += el_size;
+        right -= el_size;
+    }
+
+    elem.swap(begin, right);
+    return (size_t) (right - begin) / el_size;
+}
@@ -0,0 +1,170 @@
+/** @file */
+#ifndef SORT_STATIC_H
+#define SORT_STATIC_H
+
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "log.h"
+#include "algorithm.h"
+
+//================================================================================================================================
+
+static const size_t SORT_INSERTION_THRESHOLD = 16;  ///< максимальный размер участка, который сортируется вставками
+static const size_t SORT_NINTHER_THRESHOLD   = 128; ///< размер участка, начиная с которого опорный элемент выбирается медианой девяти
+static const size_t SORT_TEMP_SIZE           = 256; ///< размер буфера на стеке под временный элемент
+static const size_t SORT_PARTIAL_LIMIT       = 8;   ///< количество перемещений, после которого частичная сортировка вставками сдается
+
+static const size_t SORT_PARALLEL_MIN_CHUNK   = 1UL << 14; ///< минимальное количество элементов на один поток параллельной сортировки
+static const size_t SORT_PARALLEL_MAX_THREADS = 64;        ///< максимальное количество потоков параллельной сортировки
+static const size_t SORT_PARALLEL_BUFFER_SIZE = 1UL << 18; ///< размер буфера слияния одного потока параллельной сортировки (в байтах)
+
+//================================================================================================================================
+
+/**
+*   @brief Элемент сортировки фиксированного размера.
+*   Обмен и копирование выполняются через переменные типа word_t, которые компилятор держит в регистрах.
+*/
+template <typename word_t>
+struct sort_fixed
+{
+    size_t size() const { return sizeof(word_t); }
+
+    void copy(char *dst, const char *src) const { memcpy(dst, src, sizeof(word_t)); }
+    void swap(char *a  , char       *b  ) const
+    {
+        word_t temp_a, temp_b;
+        memcpy(&temp_a, a, sizeof(word_t));
+        memcpy(&temp_b, b, sizeof(word_t));
+        memcpy(a, &temp_b, sizeof(word_t));
+        memcpy(b, &temp_a, sizeof(word_t));
+    }
+};
+
+/**
+*   @brief 16-байтовое слово для сортировки элементов размера 16.
+*/
+struct sort_word_16
+{
+    uint64_t lo;
+    uint64_t hi;
+};
+
+/**
+*   @brief Элемент сортировки произвольного размера.
+*   Обмен идет 16-байтовыми словами, а не через my_swap(): сортировка вызывается из нескольких потоков,
+*   а my_swap() в отладочной сборке пишет в общий стек trace-а.
+*/
+struct sort_dynamic
+{
+    size_t el_size;
+
+    size_t size() const { return el_size; }
+
+    void copy(char *dst, const char *src) const { memcpy(dst, src, el_size); }
+    void swap(char *a  , char       *b  ) const
+    {
+        size_t rest = el_size;
+
+        for (; rest >= sizeof(sort_word_16); rest -= sizeof(sort_word_16))
+        {
+            sort_fixed<sort_word_16>().swap(a, b);
+            a += sizeof(sort_word_16);
+            b += sizeof(sort_word_16);
+        }
+
+        if (rest >= 8) { sort_fixed<uint64_t>().swap(a, b); a += 8; b += 8; rest -= 8; }
+        if (rest >= 4) { sort_fixed<uint32_t>().swap(a, b); a += 4; b += 4; rest -= 4; }
+        if (rest >= 2) { sort_fixed<uint16_t>().swap(a, b); a += 2; b += 2; rest -= 2; }
+        if (rest >= 1) { sort_fixed<uint8_t >().swap(a, b); }
+    }
+};
+
+/**
+*   @brief Задание для потока параллельной сортировки.
+*   Сортировка: участок [begin, begin + left_n) сортируется на месте.
+*   Слияние: участки [begin, begin + left_n) и [begin + left_n, begin + left_n + right_n) сливаются на месте.
+*   Задание выполняется в threads потоков, у каждого из которых свой буфер на buffer_n элементов, буферы лежат подряд начиная с buffer.
+*/
+struct sort_task
+{
+    void (*run) (const sort_task *const task); ///< функция, выполняющая задание
+
+    char  *begin;       ///< начало участка
+    size_t left_n;      ///< количество элементов левого участка
+    size_t right_n;     ///< количество элементов правого участка
+    char  *buffer;      ///< буферы потоков
+    size_t buffer_n;    ///< размер буфера одного потока (в элементах)
+    size_t threads;     ///< количество потоков
+
+    size_t el_size;                                       ///< размер элемента
+    int  (*el_cmp) (const void *el_1, const void *el_2); ///< функция сравнения элементов
+
+    bool is_spawned; ///< true, если задание выполняется в отдельном потоке
+};
+
+//================================================================================================================================
+
+static void   sort_serial        (char *begin, size_t n, size_t el_size, int (*el_cmp)(const void *el_1, const void *el_2), char *temp);
+
+static size_t sort_thread_count  (size_t n, size_t thread_count);
+static void   sort_task_split    (const sort_task *const task, sort_task *parts, size_t left_n, size_t out_n);
+static size_t sort_co_rank       (const char *left, size_t left_n, const char *right, size_t right_n, size_t out_n, size_t el_size,
+                                  int (*el_cmp)(const void *el_1, const void *el_2));
+
+static void   sort_run_tasks     (sort_task *tasks, pthread_t *threads, size_t task_count, void (*run) (const sort_task *const task));
+static void  *sort_task_thread   (void *task);
+static void   sort_task_sort     (const sort_task *const task);
+static void   sort_task_merge    (const sort_task *const task);
+
+template <typename elem_t>
+static void   sort_merge_parallel(const elem_t elem, const sort_task *const task);
+
+template <typename elem_t>
+static void   sort_merge_inplace (const elem_t elem, char *begin, size_t left_n, size_t right_n, char *buffer, size_t buffer_n,
+                                  int (*el_cmp)(const void *el_1, const void *el_2));
+
+template <typename elem_t>
+static size_t sort_split         (const elem_t elem, char *begin, size_t left_n, size_t right_n, size_t out_n, char *buffer, size_t buffer_n,
+                                  int (*el_cmp)(const void *el_1, const void *el_2));
+
+template <typename elem_t>
+static void   sort_rotate        (const elem_t elem, char *begin, size_t left_n, size_t right_n, char *buffer, size_t buffer_n);
+
+template <typename elem_t>
+static void   sort_merge         (const elem_t elem, const char *left, size_t left_n, const char *right, size_t right_n, char *dst,
+                                  int (*el_cmp)(const void *el_1, const void *el_2));
+
+template <typename elem_t>
+static void   sort_merge_back    (const elem_t elem, char *left, size_t left_n, const char *right, size_t right_n,
+                                  int (*el_cmp)(const void *el_1, const void *el_2));
+
+template <typename elem_t>
+static void   sort_intro         (const elem_t elem, char *begin, size_t n, int (*el_cmp)(const void *el_1, const void *el_2), char *temp, size_t depth_limit, bool leftmost);
+
+template <typename elem_t>
+static bool   sort_insertion     (const elem_t elem, char *begin, size_t n, int (*el_cmp)(const void *el_1, const void *el_2), char *temp, size_t move_limit);
+
+template <typename elem_t>
+static void   sort_heap          (const elem_t elem, char *begin, size_t n, int (*el_cmp)(const void *el_1, const void *el_2));
+
+template <typename elem_t>
+static void   sort_sift_down     (const elem_t elem, char *begin, size_t n, size_t root, int (*el_cmp)(const void *el_1, const void *el_2));
+
+template <typename elem_t>
+static void   sort_pivot         (const elem_t elem, char *begin, size_t n, int (*el_cmp)(const void *el_1, const void *el_2));
+
+template <typename elem_t>
+static void   sort_3             (const elem_t elem, char *a, char *b, char *c, int (*el_cmp)(const void *el_1, const void *el_2));
+
+template <typename elem_t>
+static size_t sort_partition     (const elem_t elem, char *begin, size_t n, int (*el_cmp)(const void *el_1, const void *el_2), bool *const was_partitioned);
+
+template <typename elem_t>
+static size_t sort_partition_left(const elem_t elem, char *begin, size_t n, int (*el_cmp)(const void *el_1, const void *el_2));
+
+static size_t sort_depth_limit   (size_t n);
+
+#endif // SORT_STATIC_H
@@ -0,0 +1,495 @@
+#include "allocator_static.h"
+
+//================================================================================================================================
+// ALLOCATOR
+//================================================================================================================================
+
+void *allocator_calloc(allocator *const alc, const size_t number, const size_t size)
+{
+    if (alc == nullptr) return LOG_CALLOC(number, size);
+
+    LOG_VERIFY(size == 0 || number <= SIZE_MAX / size, nullptr);
+    return alc->alloc_fn(alc, number * size);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void *allocator_recalloc(allocator *const alc, void *const ptr, const size_t old_size, const size_t new_size)
+{
+    if (alc == nullptr) return LOG_RECALLOC(ptr, old_size, new_size);
+    return alc->realloc_fn(alc, ptr, old_size, new_size);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void allocator_free(allocator *const alc, void *const ptr, const size_t size)
+{
+    if (alc == nullptr) { LOG_FREE(ptr); return; }
+    if (ptr == nullptr) return;
+
+    alc->free_fn(alc, ptr, size);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static inline size_t allocator_align(const size_t size)
+{
+    return (size + ALLOCATOR_ALIGNMENT - 1) & ~(ALLOCATOR_ALIGNMENT - 1);
+}
+
+//================================================================================================================================
+// ARENA
+//================================================================================================================================
+
+bool arena_ctor(arena *const ar, const size_t block_size /* = ARENA_DEFAULT_BLOCK_SIZE */)
+{
+    LOG_VERIFY(ar != nullptr , false);
+    LOG_VERIFY(block_size > 0, false);
+
+    ar->base.alloc_fn   = arena_alloc;
+    ar->base.realloc_fn = arena_realloc;
+    ar->base.free_fn    = arena_free;
+
+    ar->first = nullptr;
+    ar->cur   = nullptr;
+    ar->pos   = nullptr;
+    ar->end   = nullptr;
+
+    ar->block_size = allocator_align(block_size);
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void arena_dtor(void *const _ar)
+{
+    if (_ar == nullptr) return;
+
+    arena *const ar = (arena *) _ar;
+
+    for (arena_block *blk = ar->first; blk != nullptr;)
+    {
+        arena_block *next = blk->next;
+        LOG_FREE(blk);
+        blk = next;
+    }
+
+    *ar = ARENA_POISON;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void arena_reset(arena *const ar)
+{
+    LOG_VERIFY(ar != nullptr, (void) 0);
+
+    ar->cur = ar->first;
+    if (ar->cur == nullptr) return;
+
+    ar->pos = (char *) (ar->cur + 1);
+    ar->end = ar->pos + ar->cur->size;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void *arena_alloc(allocator *const alc, const size_t size)
+{
+    LOG_ASSERT(alc != nullptr);
+
+    if (size == 0) return nullptr;
+
+    char *const blk = arena_bump((arena *) alc, allocator_align(size));
+    if (blk != nullptr) memset(blk, 0, size);
+
+    return blk;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void *arena_realloc(allocator *const alc, void *const ptr, const size_t old_size, const size_t new_size)
+{
+    LOG_ASSERT(alc != nullptr);
+
+    if (ptr == nullptr) return arena_alloc(alc, new_size);
+
+    arena *const ar  = (arena *) alc;
+    char  *const blk = (char  *) ptr;
+
+    const size_t old_aligned = allocator_align(old_size);
+    const size_t new_aligned = allocator_align(new_size);
+
+    if (blk + old_aligned == ar->pos && (size_t) (ar->end - blk) >= new_aligned)
+    {
+        ar->pos = blk + new_aligned;
+    }
+    else if (new_aligned > old_aligned)
+    {
+        char *const new_blk = (char *) arena_alloc(alc, new_size);
+        if (new_blk == nullptr) return nullptr;
+
+        memcpy(new_blk, blk, old_size);
+        return new_blk;
+    }
+
+    if (new_size > old_size) memset(blk + old_size, 0, new_size - old_size);
+    return blk;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void arena_free(allocator *const alc, void *const ptr, const size_t size)
+{
+    LOG_ASSERT(alc != nullptr);
+
+    arena *const ar  = (arena *) alc;
+    char  *const blk = (char  *) ptr;
+
+    if (blk + allocator_align(size) == ar->pos) ar->pos = blk;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static char *arena_bump(arena *const ar, const size_t size)
+{
+    LOG_ASSERT(ar != nullptr);
+    LOG_ASSERT(size % ALLOCATOR_ALIGNMENT == 0);
+
+    if ((size_t) (ar->end - ar->pos) < size && !arena_next_block(ar, size))
+        return nullptr;
+
+    char *const blk = ar->pos;
+    ar->pos += size;
+
+    return blk;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Делает текущим следующий блок арены, в котором поместится size байт.
+*   После arena_reset() сначала используются уже выделенные блоки, новый блок вставляется в цепочку за текущим.
+*/
+static bool arena_next_block(arena *const ar, const size_t size)
+{
+    LOG_ASSERT(ar != nullptr);
+
+    arena_block *next = (ar->cur == nullptr) ? ar->first : ar->cur->next;
+
+    if (next == nullptr || next->size < size)
+    {
+        const size_t block_size = (size > ar->block_size) ? size : ar->block_size;
+
+        arena_block *const blk = (arena_block *) LOG_CALLOC(1, sizeof(arena_block) + block_size);
+        if (blk == nullptr)
+        {
+            LOG_ERROR("log_calloc(1, sizeof(arena_block) = %lu + block_size = %lu) returns nullptr\n", sizeof(arena_block), block_size);
+            return false;
+        }
+
+        blk->next = next;
+        blk->size = block_size;
+
+        if (ar->cur == nullptr) ar->first     = blk;
+        else                    ar->cur->next = blk;
+
+        if (ar->block_size < ARENA_MAX_BLOCK_SIZE) ar->block_size *= 2;
+        next = blk;
+    }
+
+    ar->cur = next;
+    ar->pos = (char *) (next + 1);
+    ar->end = ar->pos + next->size;
+
+    return true;
+}
+
+//================================================================================================================================
+// POOL
+//================================================================================================================================
+
+bool pool_ctor(pool *const pl, const size_t slab_size /* = ARENA_DEFAULT_BLOCK_SIZE */)
+{
+    LOG_VERIFY(pl != nullptr, false);
+
+    if (!arena_ctor(&pl->slabs, slab_size)) return false;
+
+    pl->base.alloc_fn   = pool_alloc;
+    pl->base.realloc_fn = pool_realloc;
+    pl->base.free_fn    = pool_free;
+
+    for (size_t i = 0; i < POOL_CLASS_COUNT; ++i) pl->free_lists[i] = nullptr;
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void pool_dtor(void *const _pl)
+{
+    if (_pl == nullptr) return;
+
+    pool *const pl = (pool *) _pl;
+
+    arena_dtor(&pl->slabs);
+    for (size_t i = 0; i < POOL_CLASS_COUNT; ++i) pl->free_lists[i] = nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void pool_reset(pool *const pl)
+{
+    LOG_VERIFY(pl != nullptr, (void) 0);
+
+    arena_reset(&pl->slabs);
+    for (size_t i = 0; i < POOL_CLASS_COUNT; ++i) pl->free_lists[i] = nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static size_t pool_class(const size_t size)
+{
+    LOG_ASSERT(size <= POOL_MAX_CLASS_SIZE);
+
+    if (size <= (1UL << POOL_MIN_CLASS_LOG)) return 0;
+
+    const size_t size_log = (size_t) (64 - __builtin_clzl(size - 1));
+    return size_log - POOL_MIN_CLASS_LOG;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void *pool_alloc(allocator *const alc, const size_t size)
+{
+    LOG_ASSERT(alc != nullptr);
+
+    if (size == 0)                  return nullptr;
+    if (size > POOL_MAX_CLASS_SIZE) return LOG_CALLOC(1, size);
+
+    pool *const  pl        = (pool *) alc;
+    const size_t class_num = pool_class(size);
+
+    char *blk = (char *) pl->free_lists[class_num];
+
+    if (blk != nullptr) pl->free_lists[class_num] = *(void **) blk;
+    else
+    {
+        blk = arena_bump(&pl->slabs, 1UL << (class_num + POOL_MIN_CLASS_LOG));
+        if (blk == nullptr) return nullptr;
+    }
+
+    memset(blk, 0, size);
+    return blk;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void *pool_realloc(allocator *const alc, void *const ptr, const size_t old_size, const size_t new_size)
+{
+    LOG_ASSERT(alc != nullptr);
+
+    if (ptr == nullptr) return pool_alloc(alc, new_size);
+
+    const bool is_old_large = old_size > POOL_MAX_CLASS_SIZE;
+    const bool is_new_large = new_size > POOL_MAX_CLASS_SIZE;
+
+    if (is_old_large && is_new_large) return LOG_RECALLOC(ptr, old_size, new_size);
+
+    if (!is_old_large && !is_new_large && pool_class(old_size) == pool_class(new_size))
+    {
+        if (new_size > old_size) memset((char *) ptr + old_size, 0, new_size - old_size);
+        return ptr;
+    }
+
+    void *const new_blk = pool_alloc(alc, new_size);
+    if (new_blk == nullptr) return nullptr;
+
+    memcpy(new_blk, ptr, (old_size < new_size) ? old_size : new_size);
+    pool_free(alc, ptr, old_size);
+
+    return new_blk;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void pool_free(allocator *const alc, void *const ptr, const size_t size)
+{
+    LOG_ASSERT(alc != nullptr);
+
+    if (size > POOL_MAX_CLASS_SIZE) { LOG_FREE(ptr); return; }
+
+    pool *const  pl        = (pool *) alc;
+    const size_t class_num = pool_class(size);
+
+    *(void **) ptr = pl->free_lists[class_num];
+    pl->free_lists[class_num] = ptr;
+}
+
+//================================================================================================================================
+// SLAB
+//================================================================================================================================
+
+bool slab_ctor(slab *const sl, const size_t block_size, const size_t chunk_blocks /* = SLAB_DEFAULT_CHUNK_BLOCKS */)
+{
+    LOG_VERIFY(sl != nullptr            , false);
+    LOG_VERIFY(block_size   > 0         , false);
+    LOG_VERIFY(chunk_blocks > 0         , false);
+    LOG_VERIFY(block_size <= SIZE_MAX / chunk_blocks, false);
+
+    sl->block_size = allocator_align(block_size);
+    sl->free_list  = nullptr;
+
+    if (!arena_ctor(&sl->chunks, sl->block_size * chunk_blocks)) return false;
+
+    sl->base.alloc_fn   = slab_alloc;
+    sl->base.realloc_fn = slab_realloc;
+    sl->base.free_fn    = slab_free;
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void slab_dtor(void *const _sl)
+{
+    if (_sl == nullptr) return;
+
+    slab *const sl = (slab *) _sl;
+
+    arena_dtor(&sl->chunks);
+    sl->free_list = nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void slab_reset(slab *const sl)
+{
+    LOG_VERIFY(sl != nullptr, (void) 0);
+
+    arena_reset(&sl->chunks);
+    sl->free_list = nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/*
+*   Куски src вставляются в начало цепочки арены dst, то есть до текущего куска: арена берет новые куски только после текущего,
+*   поэтому в занятые блоки src она не попадет, а после slab_reset() переиспользует и их.
+*/
+bool slab_absorb(slab *const dst, slab *const src)
+{
+    LOG_VERIFY(dst != nullptr                     , false);
+    LOG_VERIFY(src != nullptr                     , false);
+    LOG_VERIFY(dst != src                         , false);
+    LOG_VERIFY(dst->block_size == src->block_size , false);
+
+    arena *const from = &src->chunks;
+    arena *const to   = &dst->chunks;
+
+    for (; from->cur != nullptr && (size_t) (from->end - from->pos) >= src->block_size; from->pos += src->block_size)
+    {
+        *(void **) from->pos = src->free_list;
+        src->free_list       = from->pos;
+    }
+
+    if (src->free_list != nullptr)
+    {
+        void *tail = src->free_list;
+        while (*(void **) tail != nullptr) tail = *(void **) tail;
+
+        *(void **) tail = dst->free_list;
+        dst->free_list  = src->free_list;
+    }
+
+    if (from->first != nullptr)
+    {
+        arena_block *last = from->first;
+        while (last->next != nullptr) last = last->next;
+
+        last->next = to->first;
+        to->first  = from->first;
+
+        if (to->cur == nullptr)
+        {
+            to->cur = last;
+            to->pos = to->end = (char *) (last + 1) + last->size;
+        }
+    }
+
+    if (to->block_size < from->block_size) to->block_size = from->block_size;
+
+    src->free_list = nullptr;
+    from->first    = nullptr;
+    from->cur      = nullptr;
+    from->pos      = nullptr;
+    from->end      = nullptr;
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void *slab_alloc(allocator *const alc, const size_t size)
+{
+    LOG_ASSERT(alc != nullptr);
+
+    slab *const sl = (slab *) alc;
+
+    if (size == 0)              return nullptr;
+    if (size > sl->block_size)  return LOG_CALLOC(1, size);
+
+    char *blk = (char *) sl->free_list;
+
+    if (blk != nullptr) sl->free_list = *(void **) blk;
+    else
+    {
+        blk = arena_bump(&sl->chunks, sl->block_size);
+        if (blk == nullptr) return nullptr;
+    }
+
+    memset(blk, 0, size);
+    return blk;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void *slab_realloc(allocator *const alc, void *const ptr, const size_t old_size, const size_t new_size)
+{
+    LOG_ASSERT(alc != nullptr);
+
+    if (ptr == nullptr) return slab_alloc(alc, new_size);
+
+    const size_t block_size   = ((slab *) alc)->block_size;
+    const bool   is_old_large = old_size > block_size;
+    const bool   is_new_large = new_size > block_size;
+
+    if (is_old_large && is_new_large) return LOG_RECALLOC(ptr, old_size, new_size);
+
+    if (!is_old_large && !is_new_large)
+    {
+        if (new_size > old_size) memset((char *) ptr + old_size, 0, new_size - old_size);
+        return ptr;
+    }
+
+    void *const new_blk = slab_alloc(alc, new_size);
+    if (new_blk == nullptr) return nullptr;
+
+    memcpy(new_blk, ptr, (old_size < new_size) ? old_size : new_size);
+    slab_free(alc, ptr, old_size);
+
+    return new_blk;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void slab_free(allocator *const alc, void *const ptr, const size_t size)
+{
+    LOG_ASSERT(alc != nullptr);
+
+    slab *const sl = (slab *) alc;
+
+    if (size > sl->block_size) { LOG_FREE(ptr); return; }
+
+    *(void **) ptr = sl->free_list;
+    sl->free_list  = ptr;
+}
@@ -0,0 +1,59 @@
+/** @file */
+#ifndef ALLOCATOR_STATIC_H
+#define ALLOCATOR_STATIC_H
+
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define LOG_NTRACE
+
+#include "log.h"
+#include "allocator.h"
+
+//================================================================================================================================
+
+const size_t ARENA_DEFAULT_BLOCK_SIZE  = 1UL << 16;
+const size_t SLAB_DEFAULT_CHUNK_BLOCKS = 64;
+
+static const size_t ARENA_MAX_BLOCK_SIZE = 1UL << 26;            ///< размер блока, после которого арена перестает удваивать новые блоки
+static const size_t ALLOCATOR_ALIGNMENT  = alignof(max_align_t); ///< выравнивание всех блоков арены и пула
+
+static const size_t POOL_MIN_CLASS_LOG  = 4;                                                  ///< log2 наименьшего класса размеров пула
+static const size_t POOL_MAX_CLASS_SIZE = 1UL << (POOL_MIN_CLASS_LOG + POOL_CLASS_COUNT - 1); ///< наибольший класс размеров пула
+
+static const arena ARENA_POISON =
+{
+    .base = { .alloc_fn = nullptr, .realloc_fn = nullptr, .free_fn = nullptr },
+
+    .first = (arena_block *) 0xDEADBEEF,
+    .cur   = (arena_block *) 0xBADCAB1E,
+
+    .pos = (char *) 0xABADBABE,
+    .end = (char *) 0xCAFED00D,
+
+    .block_size = 0xFACEB00C,
+};
+
+//================================================================================================================================
+
+static void        *arena_alloc         (allocator *const alc, const size_t size);
+static void        *arena_realloc       (allocator *const alc, void *const ptr, const size_t old_size, const size_t new_size);
+static void         arena_free          (allocator *const alc, void *const ptr, const size_t size);
+
+static char        *arena_bump          (arena *const ar, const size_t size);
+static bool         arena_next_block    (arena *const ar, const size_t size);
+
+static void        *pool_alloc          (allocator *const alc, const size_t size);
+static void        *pool_realloc        (allocator *const alc, void *const ptr, const size_t old_size, const size_t new_size);
+static void         pool_free           (allocator *const alc, void *const ptr, const size_t size);
+
+static size_t       pool_class          (const size_t size);
+
+static void        *slab_alloc          (allocator *const alc, const size_t size);
+static void        *slab_realloc        (allocator *const alc, void *const ptr, const size_t old_size, const size_t new_size);
+static void         slab_free           (allocator *const alc, void *const ptr, const size_t size);
+
+static inline size_t allocator_align    (const size_t size);
+
+#endif // ALLOCATOR_STATIC_H
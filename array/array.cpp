@@ -223,6 +223,34 @@ $o  return ARRAY_GET(arr, arr->size);
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
+bool array_sort(array *const arr, int (*el_cmp)(const void *el_1, const void *el_2))
+{
+$i
+$   ARRAY_VERIFY(arr, false);
+    LOG_VERIFY  (el_cmp != nullptr, false);
+
+$   bool ret = my_sort(arr->data, arr->size, arr->el_size, el_cmp);
+
+$   ARRAY_ASSERT(arr);
+$o  return ret;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool array_parallel_sort(array *const arr, int (*el_cmp)(const void *el_1, const void *el_2), const size_t thread_count /* = 0 */)
+{
+$i
+$   ARRAY_VERIFY(arr, false);
+    LOG_VERIFY  (el_cmp != nullptr, false);
+
+$   bool ret = my_parallel_sort(arr->data, arr->size, arr->el_size, el_cmp, thread_count);
+
+$   ARRAY_ASSERT(arr);
+$o  return ret;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
 void array_dump(const void *const _arr)
 {
 $i
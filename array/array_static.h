@@ -7,6 +7,7 @@
 
 #include "log.h"
 #include "array.h"
+#include "algorithm.h"
 
 //================================================================================================================================
 
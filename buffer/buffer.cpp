@@ -62,20 +62,29 @@ $i
     if (buff->pos < buff->beg             ) err |= (1 << BUFF_POS_LESS_BEG);
     if (buff->pos > buff->beg + buff->size) err |= (1 << BUFF_POS_MORE_END);
 
+    if ((unsigned) buff->mode > BUFFER_MODE_STREAM) err |= (1 << BUFF_INVALID_MODE);
+
+    if (buff->mode == BUFFER_MODE_STREAM && (buff->fd < 0 || buff->size == 0 || buff->size > buff->capacity))
+        err |= (1 << BUFF_INVALID_STREAM);
+
 $o  return err;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-bool buffer_ctor(buffer *const buff, const size_t buff_size)
+bool buffer_ctor(buffer *const buff, const size_t buff_size, allocator *const alc /* = nullptr */)
 {
 $i
     LOG_VERIFY(buff != nullptr, false);
 
-$   buff->beg = (char *) LOG_CALLOC(buff_size, sizeof(char));
+    buff->alc  = alc;
+    buff->mode = BUFFER_MODE_FIXED;
+    buffer_stream_fields_init(buff);
+
+$   buff->beg = (char *) allocator_calloc(alc, buff_size, sizeof(char));
     if (buff->beg == nullptr)
     {
-$       LOG_ERROR("log_calloc(buff_size = %lu, sizeof(char) = %lu) returns nullptr\n",
+$       LOG_ERROR("allocator_calloc(buff_size = %lu, sizeof(char) = %lu) returns nullptr\n",
                               buff_size,       sizeof(char));
 $o      return false;
     }
@@ -89,7 +98,7 @@ $o  return true;
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-bool buffer_ctor(buffer *const buff, const char *const file_name)
+bool buffer_ctor(buffer *const buff, const char *const file_name, allocator *const alc /* = nullptr */)
 {
 $i
     LOG_VERIFY(buff      != nullptr, false);
@@ -97,11 +106,14 @@ $i
 
 $   if (!get_file_size(file_name, &buff->size)) { $o return false; }
     buff->size += 1;    //for null character at the end
+    buff->alc   = alc;
+    buff->mode  = BUFFER_MODE_FIXED;
+    buffer_stream_fields_init(buff);
 
-$   buff->beg = (char *) LOG_CALLOC(buff->size, sizeof(char));
+$   buff->beg = (char *) allocator_calloc(alc, buff->size, sizeof(char));
     if (buff->beg == nullptr)
     {
-$       LOG_ERROR("log_calloc(.size = %lu, sizeof(char) = %lu) returns nullptr\n",
+$       LOG_ERROR("allocator_calloc(.size = %lu, sizeof(char) = %lu) returns nullptr\n",
                          buff->size,       sizeof(char));
 $o      return false;
     }
@@ -110,6 +122,7 @@ $o      return false;
     if (stream == nullptr)
     {
 $       LOG_ERROR("fopen(\"%s\", \"r\") returns nullptr\n", file_name);
+$       allocator_free(alc, buff->beg, buff->size);
 $o      return false;
     }
 
@@ -125,6 +138,206 @@ $o  return true;
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
+bool buffer_ctor_growable(buffer *const buff, const size_t buff_size /* = DEFAULT_BUFFER_CAPACITY */, allocator *const alc /* = nullptr */)
+{
+$i
+    LOG_VERIFY(buff_size > 0, false);
+
+$   if (!buffer_ctor(buff, buff_size, alc)) { $o return false; }
+    buff->mode = BUFFER_MODE_GROWABLE;
+
+    BUFFER_ASSERT(buff);
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool buffer_map(buffer *const buff, const char *const file_name, const BUFFER_ACCESS_TYPE access /* = BUFFER_ACCESS_SEQUENTIAL */)
+{
+$i
+    LOG_VERIFY(buff      != nullptr                , false);
+    LOG_VERIFY(file_name != nullptr                , false);
+    LOG_VERIFY((unsigned) access <= BUFFER_ACCESS_RANDOM, false);
+
+$   const int fd = open(file_name, O_RDONLY);
+    if (fd == -1)
+    {
+$       LOG_ERROR("open(\"%s\", O_RDONLY) returns -1\n", file_name);
+$o      return false;
+    }
+
+    struct stat file_info = {};
+    if (fstat(fd, &file_info) == -1)
+    {
+$       LOG_ERROR("system call \"fstat\" of file \"%s\" returns -1\n", file_name);
+$       close(fd);
+$o      return false;
+    }
+
+    const size_t file_size = (size_t) file_info.st_size;
+    const size_t map_size  = buffer_map_size(file_size + 1);
+
+    // Резервируем нулевые страницы под файл и завершающий '\0' и отображаем файл поверх них.
+    // Хвост последней страницы файла ядро тоже заполняет нулями, так что '\0' после файла есть всегда.
+$   void *const beg = mmap(nullptr, map_size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (beg == MAP_FAILED)
+    {
+$       LOG_ERROR("mmap(size = %lu) of anonymous memory returns MAP_FAILED\n", map_size);
+$       close(fd);
+$o      return false;
+    }
+
+    if (file_size != 0 && mmap(beg, file_size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+$       LOG_ERROR("mmap(size = %lu) of file \"%s\" returns MAP_FAILED\n", file_size, file_name);
+$       munmap(beg, map_size);
+$       close(fd);
+$o      return false;
+    }
+$   close(fd);
+
+    if (file_size != 0 && madvise(beg, file_size, BUFFER_MADVISE[access]) == -1)
+    {
+$       LOG_WARNING("madvise(size = %lu, advice = %d) returns -1\n", file_size, BUFFER_MADVISE[access]);
+    }
+
+    buff->beg  = (char *) beg;
+    buff->pos  = buff->beg;
+    buff->size = file_size + 1;
+    buff->alc  = nullptr;
+    buff->mode = BUFFER_MODE_MAPPED;
+    buffer_stream_fields_init(buff);
+
+    BUFFER_ASSERT(buff);
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static size_t buffer_map_size(const size_t size)
+{
+    const size_t page_size = (size_t) sysconf(_SC_PAGESIZE);
+    return (size + page_size - 1) / page_size * page_size;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void buffer_stream_fields_init(buffer *const buff)
+{
+    LOG_ASSERT(buff != nullptr);
+
+    buff->fd          = -1;
+    buff->capacity    = 0;
+    buff->is_eof      = false;
+    buff->is_fd_owned = false;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool buffer_open(buffer *const buff, const int fd, const size_t chunk_size /* = DEFAULT_BUFFER_CHUNK_SIZE */,
+                                                   allocator *const alc    /* = nullptr */)
+{
+$i
+    LOG_VERIFY(buff != nullptr, false);
+    LOG_VERIFY(fd   >= 0      , false);
+    LOG_VERIFY(chunk_size > 0 , false);
+
+$   if (!buffer_ctor(buff, chunk_size + 1, alc)) { $o return false; }
+
+    buff->mode        = BUFFER_MODE_STREAM;
+    buff->fd          = fd;
+    buff->capacity    = chunk_size + 1;
+    buff->size        = 1;  // пустое окно: только '\0'
+    buff->is_eof      = false;
+    buff->is_fd_owned = false;
+
+    BUFFER_ASSERT(buff);
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool buffer_open(buffer *const buff, const char *const file_name, const size_t chunk_size /* = DEFAULT_BUFFER_CHUNK_SIZE */,
+                                                                  allocator *const alc    /* = nullptr */)
+{
+$i
+    LOG_VERIFY(file_name != nullptr, false);
+
+$   const int fd = open(file_name, O_RDONLY);
+    if (fd == -1)
+    {
+$       LOG_ERROR("open(\"%s\", O_RDONLY) returns -1\n", file_name);
+$o      return false;
+    }
+
+$   if (!buffer_open(buff, fd, chunk_size, alc))
+    {
+$       close(fd);
+$o      return false;
+    }
+    buff->is_fd_owned = true;
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool buffer_refill(buffer *const buff)
+{
+$i
+$   BUFFER_VERIFY(buff, false);
+    LOG_VERIFY(buff->mode == BUFFER_MODE_STREAM, false);
+
+    if (buff->is_eof) { $o return false; }
+
+    // непрочитанный хвост окна (возможно, начало разрезанного токена) переезжает в начало окна
+    const size_t tail = buff->size - 1 - (size_t) (buff->pos - buff->beg);
+
+$   memmove(buff->beg, buff->pos, tail);
+    buff->pos  = buff->beg;
+    buff->size = tail + 1;
+
+    if (buff->size == buff->capacity)
+    {
+$       char *beg_new = (char *) allocator_recalloc(buff->alc, buff->beg, buff->capacity, 2 * buff->capacity);
+        if (beg_new == nullptr)
+        {
+$           LOG_ERROR("allocator_recalloc(.capacity = %lu, capacity_new = %lu) returns nullptr\n", buff->capacity, 2 * buff->capacity);
+            buff->beg[buff->size - 1] = '\0';
+$o          return false;
+        }
+        buff->beg       = beg_new;
+        buff->pos       = beg_new;
+        buff->capacity *= 2;
+    }
+
+    size_t read_total = 0;
+    bool   is_ok      = true;
+
+$   while (buff->size < buff->capacity)
+    {
+        const ssize_t read_size = read(buff->fd, buff->beg + buff->size - 1, buff->capacity - buff->size);
+
+        if (read_size == -1 && errno == EINTR) continue;
+        if (read_size == -1)
+        {
+$           LOG_ERROR("system call \"read\" of descriptor %d returns -1\n", buff->fd);
+            is_ok = false;
+            break;
+        }
+        if (read_size == 0) { buff->is_eof = true; break; }
+
+        buff->size += (size_t) read_size;
+        read_total += (size_t) read_size;
+    }
+    buff->beg[buff->size - 1] = '\0';
+
+    BUFFER_ASSERT(buff);
+$o  return is_ok && read_total != 0;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
 buffer *buffer_new(const size_t buff_size)
 {
 $i
@@ -196,7 +409,12 @@ $i
     buffer *const buff = (buffer *) _buff;
 $   BUFFER_VERIFY(buff, (void) 0);
 
-$   LOG_FREE(buff->beg);
+    if      (buff->mode == BUFFER_MODE_MAPPED) { $ munmap(buff->beg, buffer_map_size(buff->size)); }
+    else if (buff->mode == BUFFER_MODE_STREAM) { $ allocator_free(buff->alc, buff->beg, buff->capacity); }
+    else                                       { $ allocator_free(buff->alc, buff->beg, buff->size); }
+
+    if (buff->is_fd_owned) { $ close(buff->fd); }
+
     *buff = BUFF_POISON;
 $o
 }
@@ -234,8 +452,11 @@ char *buffer_back(const buffer *const buff)
 bool buffer_write(buffer *const buff, const void *data, const size_t data_size)
 {
 $i
-$   BUFFER_VERIFY(buff           , false);
-    LOG_VERIFY   (data != nullptr, false);
+$   BUFFER_VERIFY(buff                              , false);
+    LOG_VERIFY   (data != nullptr                   , false);
+    LOG_VERIFY   (buffer_is_writable(buff)          , false);
+
+$   if (buff->mode == BUFFER_MODE_GROWABLE && !buffer_grow(buff, data_size)) { $o return false; }
 
     size_t buff_size_left  = buff->size - (size_t) (buff->pos - buff->beg);
     size_t buff_size_write = (buff_size_left < data_size) ? buff_size_left : data_size;
@@ -248,63 +469,970 @@ $o  return buff_size_write == data_size;
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-void buffer_dump(const void *const _buff)
+bool buffer_reserve(buffer *const buff, const size_t data_size)
 {
 $i
-    const buffer *buff = (const buffer *) _buff;
-$   BUFFER_VERIFY(buff, (void) 0);
-$   buffer_static_dump(buff, false);
-$o
+$   BUFFER_VERIFY(buff, false);
+
+    if (buff->mode == BUFFER_MODE_GROWABLE) { $ bool ret = buffer_grow(buff, data_size); $o return ret; }
+
+$o  return buffer_is_writable(buff) && data_size <= buff->size - (size_t) (buff->pos - buff->beg);
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static void buffer_static_dump(const buffer *const buff, const bool is_full)
+static bool buffer_is_writable(const buffer *const buff)
+{
+    LOG_ASSERT(buff != nullptr);
+    return buff->mode == BUFFER_MODE_FIXED || buff->mode == BUFFER_MODE_GROWABLE;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static bool buffer_grow(buffer *const buff, const size_t data_size)
 {
 $i
-$   if (!buffer_header_dump(buff)) { $o return; }
+    LOG_ASSERT(buff       != nullptr);
+    LOG_ASSERT(buff->mode == BUFFER_MODE_GROWABLE);
 
-$   bool are_invalid_public_fields =           buffer_public_fields_dump(buff);
-$   bool are_invalid_static_fields = is_full ? buffer_static_fields_dump(buff) : false;
-    bool are_invalid_fields        = are_invalid_public_fields | are_invalid_static_fields;
+    const size_t used = (size_t) (buff->pos - buff->beg);
+    if (data_size <= buff->size - used) { $o return true; }
 
-$   buffer_content_dump(buff, are_invalid_fields);
+    size_t size_new = 2 * buff->size;
+    if    (size_new < used + data_size) size_new = used + data_size;
 
-    LOG_TAB--;
-$   LOG_TAB_SERVICE_MESSAGE("}", "\n\n");
-$o
+$   char *beg_new = (char *) allocator_recalloc(buff->alc, buff->beg, buff->size, size_new);
+    if (beg_new == nullptr)
+    {
+$       LOG_ERROR("allocator_recalloc(.size = %lu, size_new = %lu) returns nullptr\n", buff->size, size_new);
+$o      return false;
+    }
+
+    buff->beg  = beg_new;
+    buff->pos  = beg_new + used;
+    buff->size = size_new;
+
+$o  return true;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static bool __always_inline buffer_header_dump(const buffer *const buff)
+bool buffer_printf(buffer *const buff, const char *fmt, ...)
 {
 $i
-$   LOG_TAB_SERVICE_MESSAGE("buffer (address: %p)\n"
-                            "{", "\n", buff);
+$   BUFFER_VERIFY(buff, false);
+    LOG_VERIFY(fmt != nullptr, false);
+    LOG_VERIFY(buffer_is_writable(buff), false);
 
-$   if (buff == nullptr)
+    va_list ap;
+    va_start(ap, fmt);
+
+    va_list ap_retry;
+    va_copy(ap_retry, ap);
+
+    size_t left = buff->size - (size_t) (buff->pos - buff->beg);
+    int    len  = vsnprintf(buff->pos, left, fmt, ap);
+    va_end(ap);
+
+    bool is_ok = len >= 0;
+    if  (is_ok && (size_t) len >= left)
     {
-        LOG_TAB_SERVICE_MESSAGE("}", "\n");
-$o      return false;
+        // не поместилось: растим буфер и форматируем еще раз (для нерастущего буфера - откатываем запись)
+        if ((is_ok = buffer_reserve(buff, (size_t) len + 1)))
+        {
+            left = buff->size - (size_t) (buff->pos - buff->beg);
+            len  = vsnprintf(buff->pos, left, fmt, ap_retry);
+        }
+        else if (left != 0) *buff->pos = '\0';
     }
+    va_end(ap_retry);
+
+    if (is_ok) buff->pos += len;
+
+$o  return is_ok;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool buffer_append_u64(buffer *const buff, const uint64_t val)
+{
+$i
+$   BUFFER_VERIFY(buff, false);
+    LOG_VERIFY(buffer_is_writable(buff), false);
+
+    size_t len = 1;
+    for (uint64_t pow_10 = 10; len < BUFFER_U64_MAX_LEN && val >= pow_10; pow_10 *= 10) ++len;
+
+$   if (!buffer_reserve(buff, len)) { $o return false; }
+
+    // цифры пишутся с конца, по две за шаг
+    char    *cur  = buff->pos + len;
+    uint64_t rest = val;
+
+    while (rest >= 100)
+    {
+        const uint64_t pair = rest % 100 * 2;
+        rest /= 100;
+
+        *--cur = BUFFER_DIGIT_PAIRS[pair + 1];
+        *--cur = BUFFER_DIGIT_PAIRS[pair];
+    }
+    if (rest >= 10)
+    {
+        *--cur = BUFFER_DIGIT_PAIRS[rest * 2 + 1];
+        *--cur = BUFFER_DIGIT_PAIRS[rest * 2];
+    }
+    else *--cur = (char) ('0' + rest);
+
+    buff->pos += len;
 
-    LOG_TAB++;
 $o  return true;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-bool buffer_public_fields_dump(const buffer *const buff)
+bool buffer_append_double(buffer *const buff, const double val)
 {
 $i
-    LOG_ASSERT(buff != nullptr);
+$   BUFFER_VERIFY(buff, false);
+    LOG_VERIFY(buffer_is_writable(buff), false);
 
-    bool is_any_invalid = false;
-    long rel_pos        = buff->pos - buff->beg;
+    // растущий буфер расширяется заранее, чтобы число форматировалось один раз
+$   if (buff->mode == BUFFER_MODE_GROWABLE && !buffer_grow(buff, BUFFER_DOUBLE_MAX_LEN + 1)) { $o return false; }
 
-    if (buff->size == BUFF_POISON.size)      { $ POISON_FIELD_DUMP("size             "); is_any_invalid = true; }
-    else                                     { $ USUAL_FIELD_DUMP ("size             ", "%lu", buff->size); }
+$   bool   ret = buffer_printf(buff, "%.17g", val);
+$o  return ret;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool buffer_delims_ctor(buffer_delims *const delims, const char *const chars)
+{
+$i
+    LOG_VERIFY(delims != nullptr, false);
+    LOG_VERIFY(chars  != nullptr, false);
+
+$   memset(delims, 0, sizeof(buffer_delims));
+
+    // '\0' - конец данных, на нем останавливается любой поиск
+    delims->is_delim[0] = true;
+    delims->chars   [0] = '\0';
+
+    size_t chars_count = 1;
+    for (const char *cur = chars; *cur != '\0'; ++cur)
+    {
+        const unsigned char c = (unsigned char) *cur;
+        if (delims->is_delim[c]) continue;
+
+        delims->is_delim[c] = true;
+        if (chars_count < BUFFER_DELIMS_SIMD_MAX) delims->chars[chars_count] = *cur;
+        ++chars_count;
+    }
+    delims->chars_count = (chars_count <= BUFFER_DELIMS_SIMD_MAX) ? chars_count : 0;
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool buffer_next_line(buffer *const buff, buffer_token *const line)
+{
+$i
+$   BUFFER_VERIFY(buff, false);
+    LOG_VERIFY(line != nullptr, false);
+
+    char *cur = buff->pos;
+    do { $ cur = buffer_find_eol(cur, buff->beg + buff->size); }
+    while (buffer_is_data_end(buff, cur) && buffer_stream_more(buff, &cur));
+
+    const bool is_end = buffer_is_data_end(buff, cur);
+    if (is_end && cur == buff->pos) { $o return false; }
+
+    line->ptr = buff->pos;
+    line->len = (size_t) (cur - buff->pos);
+    buff->pos = is_end ? cur : cur + 1;
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool buffer_next_token(buffer *const buff, const buffer_delims *const delims, buffer_token *const token)
+{
+$i
+$   BUFFER_VERIFY(buff, false);
+    LOG_VERIFY(delims != nullptr, false);
+    LOG_VERIFY(token  != nullptr, false);
+
+    // разделители перед токеном: обычно их несколько подряд, поэтому без SIMD
+    do
+    {
+        while (!buffer_is_data_end(buff, buff->pos) && delims->is_delim[(unsigned char) *buff->pos]) ++buff->pos;
+    }
+    while (buffer_is_data_end(buff, buff->pos) && buffer_stream_more(buff, &buff->pos));
+
+    char *cur = buff->pos;
+    do { $ cur = buffer_find_delim(cur, buff->beg + buff->size, delims); }
+    while (buffer_is_data_end(buff, cur) && buffer_stream_more(buff, &cur));
+
+    if (cur == buff->pos) { $o return false; }
+
+    token->ptr = buff->pos;
+    token->len = (size_t) (cur - buff->pos);
+    buff->pos  = buffer_is_data_end(buff, cur) ? cur : cur + 1;
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool buffer_next_int(buffer *const buff, buffer_token *const token)
+{
+$i
+$   BUFFER_VERIFY(buff, false);
+    LOG_VERIFY(token != nullptr, false);
+
+    while (isspace((unsigned char) buffer_peek(buff, 0))) ++buff->pos;
+
+    size_t len = 0;
+    char   c   = buffer_peek(buff, 0);
+
+    if (c == '+' || c == '-') c = buffer_peek(buff, ++len);
+    if (!isdigit((unsigned char) c)) { $o return false; }
+
+    while (isdigit((unsigned char) c)) c = buffer_peek(buff, ++len);
+
+    token->ptr = buff->pos;
+    token->len = len;
+    buff->pos += len;
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool buffer_next_double(buffer *const buff, buffer_token *const token)
+{
+$i
+$   BUFFER_VERIFY(buff, false);
+    LOG_VERIFY(token != nullptr, false);
+
+    while (isspace((unsigned char) buffer_peek(buff, 0))) ++buff->pos;
+
+    size_t len    = 0;
+    size_t digits = 0;
+    char   c      = buffer_peek(buff, 0);
+
+    if (c == '+' || c == '-') c = buffer_peek(buff, ++len);
+
+    for (; isdigit((unsigned char) c); ++digits) c = buffer_peek(buff, ++len);
+    if (c == '.')
+    {
+        c = buffer_peek(buff, ++len);
+        for (; isdigit((unsigned char) c); ++digits) c = buffer_peek(buff, ++len);
+    }
+    if (digits == 0) { $o return false; }
+
+    // экспонента входит в число, только если после [eE][+-]? есть цифра
+    if (c == 'e' || c == 'E')
+    {
+        size_t exp_len = len + 1;
+        c = buffer_peek(buff, exp_len);
+
+        if (c == '+' || c == '-') c = buffer_peek(buff, ++exp_len);
+        if (isdigit((unsigned char) c))
+        {
+            while (isdigit((unsigned char) c)) c = buffer_peek(buff, ++exp_len);
+            len = exp_len;
+        }
+    }
+
+    token->ptr = buff->pos;
+    token->len = len;
+    buff->pos += len;
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static bool buffer_is_data_end(const buffer *const buff, const char *const cur)
+{
+    LOG_ASSERT(buff != nullptr);
+    LOG_ASSERT(cur  != nullptr);
+
+    return cur == buff->beg + buff->size || *cur == '\0';
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Данные закончились на cur. Если это конец окна потокового буфера, подчитывает окно (данные начиная с .pos сохраняются)
+*   и пересчитывает cur в новое окно.
+*
+*   @return true, если прочитаны новые данные.
+*/
+static bool buffer_stream_more(buffer *const buff, char **const cur)
+{
+$i
+    LOG_ASSERT(buff != nullptr);
+    LOG_ASSERT(cur  != nullptr);
+
+    if (buff->mode != BUFFER_MODE_STREAM || buff->is_eof || *cur != buff->beg + buff->size - 1) { $o return false; }
+
+    const size_t offset  = (size_t) (*cur - buff->pos);
+$   const bool   is_read = buffer_refill(buff);
+    *cur = buff->pos + offset;
+
+$o  return is_read;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Символ по смещению offset от .pos ('\0', если данные закончились). Потоковый буфер при необходимости подчитывается,
+*   поэтому смещение считается от .pos, а не хранится указателем.
+*/
+static char buffer_peek(buffer *const buff, const size_t offset)
+{
+    LOG_ASSERT(buff != nullptr);
+
+    char *cur = buff->pos + offset;
+    if (!buffer_is_data_end(buff, cur) || buffer_stream_more(buff, &cur)) return *cur;
+
+    return '\0';
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Первый '\n' или '\0' в [cur, limit) или limit, если таких нет.
+*/
+static char *buffer_find_eol(char *cur, const char *const limit)
+{
+    LOG_ASSERT(cur   != nullptr);
+    LOG_ASSERT(limit != nullptr);
+
+#ifdef BUFFER_X86
+    cur = buffer_find_chars_sse2(cur, limit, BUFFER_EOL_CHARS, sizeof(BUFFER_EOL_CHARS));
+#endif
+
+    while (cur < limit && *cur != '\n' && *cur != '\0') ++cur;
+    return cur;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Первый разделитель из delims в [cur, limit) или limit, если таких нет.
+*/
+static char *buffer_find_delim(char *cur, const char *const limit, const buffer_delims *const delims)
+{
+    LOG_ASSERT(cur    != nullptr);
+    LOG_ASSERT(limit  != nullptr);
+    LOG_ASSERT(delims != nullptr);
+
+#ifdef BUFFER_X86
+    if (delims->chars_count != 0) cur = buffer_find_chars_sse2(cur, limit, delims->chars, delims->chars_count);
+#endif
+
+    while (cur < limit && !delims->is_delim[(unsigned char) *cur]) ++cur;
+    return cur;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef BUFFER_X86
+
+/**
+*   Ищет в [cur, limit) первый из chars_count символов chars, по 32 байта за итерацию.
+*   Возвращает найденный символ или начало хвоста короче 16 байт, который досматривает вызывающая функция.
+*/
+static char *buffer_find_chars_sse2(char *cur, const char *const limit, const char *const chars, const size_t chars_count)
+{
+    LOG_ASSERT(chars_count > 0 && chars_count <= BUFFER_DELIMS_SIMD_MAX);
+
+    __m128i patterns[BUFFER_DELIMS_SIMD_MAX];
+    for (size_t i = 0; i < chars_count; ++i) patterns[i] = _mm_set1_epi8(chars[i]);
+
+    for (; limit - cur >= 32; cur += 32)
+    {
+        const __m128i block_0 = _mm_loadu_si128((const __m128i *) (cur +  0));
+        const __m128i block_1 = _mm_loadu_si128((const __m128i *) (cur + 16));
+
+        __m128i eq_0 = _mm_cmpeq_epi8(block_0, patterns[0]);
+        __m128i eq_1 = _mm_cmpeq_epi8(block_1, patterns[0]);
+        for (size_t i = 1; i < chars_count; ++i)
+        {
+            eq_0 = _mm_or_si128(eq_0, _mm_cmpeq_epi8(block_0, patterns[i]));
+            eq_1 = _mm_or_si128(eq_1, _mm_cmpeq_epi8(block_1, patterns[i]));
+        }
+
+        const uint32_t mask = (uint32_t) _mm_movemask_epi8(eq_0) | ((uint32_t) _mm_movemask_epi8(eq_1) << 16);
+        if (mask != 0) return cur + __builtin_ctz(mask);
+    }
+
+    if (limit - cur >= 16)
+    {
+        const __m128i block = _mm_loadu_si128((const __m128i *) cur);
+
+        __m128i eq = _mm_cmpeq_epi8(block, patterns[0]);
+        for (size_t i = 1; i < chars_count; ++i) eq = _mm_or_si128(eq, _mm_cmpeq_epi8(block, patterns[i]));
+
+        const uint32_t mask = (uint32_t) _mm_movemask_epi8(eq);
+        if (mask != 0) return cur + __builtin_ctz(mask);
+
+        cur += 16;
+    }
+
+    return cur;
+}
+
+#endif // BUFFER_X86
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+BUFFER_READ_STATUS buffer_read_i64(buffer *const buff, int64_t *const val)
+{
+$i
+$   BUFFER_VERIFY(buff, BUFFER_READ_ERROR);
+    LOG_VERIFY(val != nullptr, BUFFER_READ_ERROR);
+
+$   const char first = buffer_skip_spaces(buff);
+    if (first == '\0') { $o return BUFFER_READ_END; }
+
+    const bool   is_negative = (first == '-');
+    const size_t sign_len    = (first == '+' || first == '-') ? 1 : 0;
+
+    uint64_t abs         = 0;
+    bool     is_overflow = false;
+$   if (!buffer_read_digits(buff, sign_len, &abs, &is_overflow)) { $o return BUFFER_READ_INVALID; }
+
+    const uint64_t abs_max = is_negative ? (uint64_t) INT64_MAX + 1 : (uint64_t) INT64_MAX;
+    if (is_overflow || abs > abs_max)
+    {
+        *val = is_negative ? INT64_MIN : INT64_MAX;
+$o      return BUFFER_READ_OVERFLOW;
+    }
+
+    *val = is_negative ? (int64_t) (0 - abs) : (int64_t) abs;
+$o  return BUFFER_READ_OK;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+BUFFER_READ_STATUS buffer_read_u64(buffer *const buff, uint64_t *const val)
+{
+$i
+$   BUFFER_VERIFY(buff, BUFFER_READ_ERROR);
+    LOG_VERIFY(val != nullptr, BUFFER_READ_ERROR);
+
+$   const char first = buffer_skip_spaces(buff);
+    if (first == '\0') { $o return BUFFER_READ_END;     }
+    if (first == '-' ) { $o return BUFFER_READ_INVALID; }
+
+    bool is_overflow = false;
+$   if (!buffer_read_digits(buff, (first == '+') ? 1 : 0, val, &is_overflow)) { $o return BUFFER_READ_INVALID; }
+
+    if (is_overflow)
+    {
+        *val = UINT64_MAX;
+$o      return BUFFER_READ_OVERFLOW;
+    }
+
+$o  return BUFFER_READ_OK;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+BUFFER_READ_STATUS buffer_read_double(buffer *const buff, double *const val)
+{
+$i
+$   BUFFER_VERIFY(buff, BUFFER_READ_ERROR);
+    LOG_VERIFY(val != nullptr, BUFFER_READ_ERROR);
+
+$   if (buffer_skip_spaces(buff) == '\0') { $o return BUFFER_READ_END; }
+
+    buffer_decimal dec        = {};
+    char          *end        = nullptr;
+    char          *stop       = nullptr;
+    char          *parsed_pos = nullptr;
+
+    // запись (вместе с символами, на которые пришлось посмотреть после нее) дошла до конца окна потокового буфера:
+    // подчитываем окно и разбираем число заново. Заново разбираем и тогда, когда новых данных нет (EOF), но окно
+    // успело сдвинуться: end и указатели dec смотрят в старое окно.
+    do
+    {
+        parsed_pos = buff->pos;
+$       end        = buffer_parse_decimal(buff->pos, buff->beg + buff->size, &dec, &stop);
+    }
+    while ((buffer_is_data_end(buff, stop) && buffer_stream_more(buff, &stop)) || buff->pos != parsed_pos);
+
+    if (end == buff->pos) { $o return BUFFER_READ_INVALID; }
+
+$   *val      = buffer_decimal_to_double(&dec);
+    buff->pos = end;
+
+$o  return isinf(*val) ? BUFFER_READ_OVERFLOW : BUFFER_READ_OK;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Пропускает пробельные символы (те же, что isspace() в локали "C"), возвращает первый непробельный ('\0', если данные закончились).
+*/
+static char __always_inline buffer_skip_spaces(buffer *const buff)
+{
+    LOG_ASSERT(buff != nullptr);
+
+    do
+    {
+        while (!buffer_is_data_end(buff, buff->pos) && buffer_is_space(*buff->pos)) ++buff->pos;
+    }
+    while (buffer_is_data_end(buff, buff->pos) && buffer_stream_more(buff, &buff->pos));
+
+    return buffer_is_data_end(buff, buff->pos) ? '\0' : *buff->pos;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static inline bool buffer_is_space(const char c)
+{
+    return c == ' ' || (unsigned char) (c - '\t') <= '\r' - '\t';
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Разбирает цифры после знака длины sign_len и сдвигает .pos за них.
+*   Если цифры дошли до конца окна потокового буфера, окно подчитывается и цифры разбираются заново.
+*
+*   @return false, если цифр нет (.pos не сдвигается).
+*/
+static bool __always_inline buffer_read_digits(buffer *const buff, const size_t sign_len, uint64_t *const val, bool *const is_overflow)
+{
+$i
+    LOG_ASSERT(buff        != nullptr);
+    LOG_ASSERT(val         != nullptr);
+    LOG_ASSERT(is_overflow != nullptr);
+
+    char *end = nullptr;
+    do
+    {
+        *val         = 0;
+        *is_overflow = false;
+$       end          = buffer_parse_digits(buff->pos + sign_len, buff->beg + buff->size, val, is_overflow);
+    }
+    while (buffer_is_data_end(buff, end) && buffer_stream_more(buff, &end));
+
+    if (end == buff->pos + sign_len) { $o return false; }
+    buff->pos = end;
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Дописывает к *val цифры из [cur, limit) до первой нецифры и возвращает указатель на нее.
+*   При переполнении uint64_t выставляет *is_overflow, цифры при этом все равно пропускаются.
+*/
+static __always_inline char *buffer_parse_digits(char *cur, const char *const limit, uint64_t *const val, bool *const is_overflow)
+{
+    LOG_ASSERT(cur         != nullptr);
+    LOG_ASSERT(limit       != nullptr);
+    LOG_ASSERT(val         != nullptr);
+    LOG_ASSERT(is_overflow != nullptr);
+
+    uint64_t res = *val;
+    bool     of  = false;
+
+#ifdef BUFFER_SWAR
+    // по 8 байт за шаг: сколько цифр в начале слова и их значение считаются без ветвлений
+    while (limit - cur >= 8)
+    {
+        uint64_t chunk = 0;
+        memcpy(&chunk, cur, sizeof(chunk));
+
+        const size_t digit_count = buffer_swar_digit_count(chunk);
+        if (digit_count == 0) break;
+
+        of  |= __builtin_mul_overflow(res, BUFFER_POW10_U64[digit_count], &res);
+        of  |= __builtin_add_overflow(res, buffer_swar_digits_value(chunk, digit_count), &res);
+        cur += digit_count;
+
+        if (digit_count < 8)
+        {
+            *val          = res;
+            *is_overflow |= of;
+            return cur;
+        }
+    }
+#endif
+
+    for (; cur < limit && isdigit((unsigned char) *cur); ++cur)
+    {
+        of |= __builtin_mul_overflow(res, 10, &res);
+        of |= __builtin_add_overflow(res, (uint64_t) (*cur - '0'), &res);
+    }
+
+    *val          = res;
+    *is_overflow |= of;
+    return cur;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef BUFFER_SWAR
+
+/**
+*   Количество цифр в начале 8-байтного слова (байты в порядке little-endian).
+*/
+static size_t buffer_swar_digit_count(const uint64_t chunk)
+{
+    // после xor цифры - байты 0..9; у остальных байтов после + 0x76 или сразу выставлен старший бит.
+    // Перенос из байта идет только в старшие байты, поэтому первая нецифра определяется верно.
+    const uint64_t shifted   = chunk ^ 0x3030303030303030;
+    const uint64_t non_digit = ((shifted + 0x7676767676767676) | shifted) & 0x8080808080808080;
+
+    return (non_digit == 0) ? 8 : (size_t) __builtin_ctzll(non_digit) / 8;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Значение первых digit_count (1..8) цифр 8-байтного слова.
+*/
+static uint64_t buffer_swar_digits_value(const uint64_t chunk, const size_t digit_count)
+{
+    LOG_ASSERT(digit_count > 0 && digit_count <= 8);
+
+    // лишние байты выталкиваются сдвигом, на их место встают ведущие нули
+    uint64_t digits = (chunk - 0x3030303030303030) << (8 * (8 - digit_count));
+
+    // складываем соседние цифры в двузначные числа, затем двузначные - в восьмизначное
+    digits = digits * 10 + (digits >> 8);
+    digits = (((digits         & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) +
+              (((digits >> 16) & 0x000000FF000000FF) * (1   + (10000ULL   << 32)))) >> 32;
+
+    return digits & 0xFFFFFFFF;
+}
+
+#endif // BUFFER_SWAR
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Разбирает запись вещественного числа, начинающуюся с cur.
+*
+*   @param stop [out] - докуда пришлось дочитать (за концом записи может быть просмотрено "e" или "e+" без цифр)
+*
+*   @return конец записи или cur, если числа нет.
+*/
+static char *buffer_parse_decimal(char *const cur, const char *const limit, buffer_decimal *const dec, char **const stop)
+{
+    LOG_ASSERT(cur   != nullptr);
+    LOG_ASSERT(limit != nullptr);
+    LOG_ASSERT(dec   != nullptr);
+    LOG_ASSERT(stop  != nullptr);
+
+    char *p = cur;
+
+    dec->is_negative = (p < limit && *p == '-');
+    if (p < limit && (*p == '+' || *p == '-')) ++p;
+
+    bool is_overflow = false; // переполнение мантиссы не важно: длинные записи разбираются заново ниже
+    dec->mantissa    = 0;
+
+    dec->int_beg = p;
+    p            = buffer_parse_digits(p, limit, &dec->mantissa, &is_overflow);
+    dec->int_end = p;
+
+    dec->frac_beg = p;
+    dec->frac_end = p;
+    if (p < limit && *p == '.')
+    {
+        dec->frac_beg = ++p;
+        p             = buffer_parse_digits(p, limit, &dec->mantissa, &is_overflow);
+        dec->frac_end = p;
+    }
+
+    const size_t int_count  = (size_t) (dec->int_end  - dec->int_beg );
+    const size_t frac_count = (size_t) (dec->frac_end - dec->frac_beg);
+
+    if (int_count + frac_count == 0)
+    {
+        *stop = p;
+        return cur;
+    }
+
+    char *end = p;
+
+    dec->exp_number = 0;
+    if (p < limit && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        const bool is_exp_negative = (p < limit && *p == '-');
+        if (p < limit && (*p == '+' || *p == '-')) ++p;
+
+        if (p < limit && isdigit((unsigned char) *p))
+        {
+            for (; p < limit && isdigit((unsigned char) *p); ++p)
+            {
+                if (dec->exp_number < BUFFER_EXP_MAX_DIGITS_VAL) dec->exp_number = 10 * dec->exp_number + (*p - '0');
+            }
+            if (is_exp_negative) dec->exp_number = -dec->exp_number;
+
+            end = p;
+        }
+    }
+    *stop = p;
+
+    dec->exp10        = dec->exp_number - (int64_t) frac_count;
+    dec->is_truncated = false;
+
+    size_t digit_count = int_count + frac_count;
+    if (digit_count <= BUFFER_MANTISSA_MAX_DIGITS) return end;
+
+    // ведущие нули не значащие
+    for (const char *lead = dec->int_beg; lead < dec->frac_end && (*lead == '0' || *lead == '.'); ++lead)
+    {
+        if (*lead == '0') --digit_count;
+    }
+    if (digit_count <= BUFFER_MANTISSA_MAX_DIGITS) return end;
+
+    // больше 19 значащих цифр: оставляем первые 19, остальные цифры целой части уходят в степень
+    dec->is_truncated = true;
+
+    uint64_t    mantissa = 0;
+    const char *digit    = dec->int_beg;
+
+    for (; mantissa < BUFFER_MANTISSA_MIN_FULL && digit < dec->int_end; ++digit) mantissa = 10 * mantissa + (uint64_t) (*digit - '0');
+
+    if (mantissa >= BUFFER_MANTISSA_MIN_FULL) dec->exp10 = dec->exp_number + (dec->int_end - digit);
+    else
+    {
+        for (digit = dec->frac_beg; mantissa < BUFFER_MANTISSA_MIN_FULL && digit < dec->frac_end; ++digit)
+            mantissa = 10 * mantissa + (uint64_t) (*digit - '0');
+
+        dec->exp10 = dec->exp_number - (digit - dec->frac_beg);
+    }
+    dec->mantissa = mantissa;
+
+    return end;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static double buffer_decimal_to_double(const buffer_decimal *const dec)
+{
+$i
+    LOG_ASSERT(dec != nullptr);
+
+    double res = 0;
+
+    if (!dec->is_truncated && BUFFER_EXACT_MIN_EXP10 <= dec->exp10 && dec->exp10 <= BUFFER_EXACT_MAX_EXP10 &&
+        dec->mantissa <= (1UL << (BUFFER_DOUBLE_MANTISSA_BITS + 1)))
+    {
+        // мантисса и степень 10 точно представимы, так что единственное округление - в умножении или делении
+        res = (double) dec->mantissa;
+        res = (dec->exp10 < 0) ? res / BUFFER_POW10_DOUBLE[-dec->exp10] : res * BUFFER_POW10_DOUBLE[dec->exp10];
+    }
+    else
+    {
+        const uint64_t bits = buffer_eisel_lemire(dec->exp10, dec->mantissa);
+
+        // значение усеченной записи лежит между mantissa и mantissa + 1: если им соответствуют разные double,
+        // нужна полная точность
+        if (dec->is_truncated && bits != buffer_eisel_lemire(dec->exp10, dec->mantissa + 1) &&
+            buffer_decimal_strtod(dec, &res)) { $o return res; }
+
+        memcpy(&res, &bits, sizeof(res));
+    }
+
+$o  return dec->is_negative ? -res : res;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Алгоритм Эйзеля-Лемира: ближайший к mantissa * 10^exp10 double (биты без знака). mantissa - точное значение записи.
+*   Повторяет compute_float() из fast_float, где доказано, что 128-битного приближения 5^exp10 достаточно всегда.
+*/
+static uint64_t buffer_eisel_lemire(const int64_t exp10, uint64_t mantissa)
+{
+    if (mantissa == 0 || exp10 < BUFFER_POW5_MIN_EXP) return 0;
+    if (exp10 > BUFFER_POW5_MAX_EXP) return (uint64_t) BUFFER_DOUBLE_INF_POWER << BUFFER_DOUBLE_MANTISSA_BITS;
+
+    const int leading_zeros = __builtin_clzll(mantissa);
+    mantissa <<= leading_zeros;
+
+    // старшие 128 бит mantissa * 5^exp10; младшая половина степени нужна, только если старших бит не хватает на 55 бит результата
+    const size_t index = (size_t) (exp10 - BUFFER_POW5_MIN_EXP);
+
+    const unsigned __int128 product = (unsigned __int128) mantissa * BUFFER_POW5_HI[index];
+    uint64_t                high    = (uint64_t) (product >> 64);
+    uint64_t                low     = (uint64_t)  product;
+
+    const uint64_t precision_mask = UINT64_MAX >> (BUFFER_DOUBLE_MANTISSA_BITS + 3);
+    if ((high & precision_mask) == precision_mask)
+    {
+        const uint64_t second_high = (uint64_t) (((unsigned __int128) mantissa * BUFFER_POW5_LO[index]) >> 64);
+
+        low += second_high;
+        if (second_high > low) ++high;
+    }
+
+    const unsigned upper_bit = (unsigned) (high >> 63);
+    const unsigned shift     = upper_bit + 64 - BUFFER_DOUBLE_MANTISSA_BITS - 3;
+
+    uint64_t res_mantissa = high >> shift;
+    int64_t  power2       = (((152170 + 65536) * exp10) >> 16) + 63 + upper_bit - leading_zeros - BUFFER_DOUBLE_MIN_EXP;
+
+    if (power2 <= 0)
+    {
+        // денормализованное число
+        if (-power2 + 1 >= 64) return 0;
+
+        res_mantissa >>= -power2 + 1;
+        res_mantissa  += res_mantissa & 1;
+        res_mantissa >>= 1;
+
+        // округление могло сделать число нормализованным
+        power2 = (res_mantissa < (1UL << BUFFER_DOUBLE_MANTISSA_BITS)) ? 0 : 1;
+        return res_mantissa | ((uint64_t) power2 << BUFFER_DOUBLE_MANTISSA_BITS);
+    }
+
+    // ровно середина между соседними double возможна только при малых степенях: округляем к четному
+    if (low <= 1 && BUFFER_ROUND_EVEN_MIN_EXP10 <= exp10 && exp10 <= BUFFER_ROUND_EVEN_MAX_EXP10 && (res_mantissa & 3) == 1 &&
+        (res_mantissa << shift) == high)
+    {
+        res_mantissa &= ~1UL;
+    }
+
+    res_mantissa  += res_mantissa & 1;
+    res_mantissa >>= 1;
+
+    if (res_mantissa >= (2UL << BUFFER_DOUBLE_MANTISSA_BITS))
+    {
+        res_mantissa = 1UL << BUFFER_DOUBLE_MANTISSA_BITS;
+        ++power2;
+    }
+    res_mantissa &= ~(1UL << BUFFER_DOUBLE_MANTISSA_BITS);
+
+    if (power2 >= BUFFER_DOUBLE_INF_POWER) return (uint64_t) BUFFER_DOUBLE_INF_POWER << BUFFER_DOUBLE_MANTISSA_BITS;
+    return res_mantissa | ((uint64_t) power2 << BUFFER_DOUBLE_MANTISSA_BITS);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Точный перевод длинной записи через strtod. Запись собирается без десятичной точки ("-123456e-7"), поэтому от локали не зависит.
+*/
+static bool buffer_decimal_strtod(const buffer_decimal *const dec, double *const res)
+{
+$i
+    LOG_ASSERT(dec != nullptr);
+    LOG_ASSERT(res != nullptr);
+
+    const size_t int_count  = (size_t) (dec->int_end  - dec->int_beg );
+    const size_t frac_count = (size_t) (dec->frac_end - dec->frac_beg);
+    const size_t str_size   = 1 + int_count + frac_count + 1 + BUFFER_U64_MAX_LEN + 1; // знак, цифры, 'e', степень, '\0'
+
+    char  local[BUFFER_FALLBACK_LOCAL_SIZE] = {};
+    char *str = (str_size <= sizeof(local)) ? local : (char *) LOG_CALLOC(str_size, sizeof(char));
+    if (str == nullptr)
+    {
+$       LOG_ERROR("LOG_CALLOC(str_size = %lu, sizeof(char) = %lu) returns nullptr\n", str_size, sizeof(char));
+$o      return false;
+    }
+
+    char *cur = str;
+    if (dec->is_negative) *cur++ = '-';
+
+    memcpy(cur, dec->int_beg , int_count ); cur += int_count;
+    memcpy(cur, dec->frac_beg, frac_count); cur += frac_count;
+    snprintf(cur, str_size - (size_t) (cur - str), "e%ld", dec->exp_number - (int64_t) frac_count);
+
+$   *res = strtod(str, nullptr);
+
+    if (str != local) { $ LOG_FREE(str); }
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void buffer_dump(const void *const _buff)
+{
+$i
+    const buffer *buff = (const buffer *) _buff;
+$   BUFFER_VERIFY(buff, (void) 0);
+$   buffer_static_dump(buff, false);
+$o
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void buffer_static_dump(const buffer *const buff, const bool is_full)
+{
+$i
+$   if (!buffer_header_dump(buff)) { $o return; }
+
+$   bool are_invalid_public_fields =           buffer_public_fields_dump(buff);
+$   bool are_invalid_static_fields = is_full ? buffer_static_fields_dump(buff) : false;
+    bool are_invalid_fields        = are_invalid_public_fields | are_invalid_static_fields;
+
+$   buffer_content_dump(buff, are_invalid_fields);
+
+    LOG_TAB--;
+$   LOG_TAB_SERVICE_MESSAGE("}", "\n\n");
+$o
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static bool __always_inline buffer_header_dump(const buffer *const buff)
+{
+$i
+$   LOG_TAB_SERVICE_MESSAGE("buffer (address: %p)\n"
+                            "{", "\n", buff);
+
+$   if (buff == nullptr)
+    {
+        LOG_TAB_SERVICE_MESSAGE("}", "\n");
+$o      return false;
+    }
+
+    LOG_TAB++;
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool buffer_public_fields_dump(const buffer *const buff)
+{
+$i
+    LOG_ASSERT(buff != nullptr);
+
+    bool is_any_invalid = false;
+    long rel_pos        = buff->pos - buff->beg;
+
+    if (buff->size == BUFF_POISON.size)      { $ POISON_FIELD_DUMP("size             "); is_any_invalid = true; }
+    else                                     { $ USUAL_FIELD_DUMP ("size             ", "%lu", buff->size); }
+
+    if ((unsigned) buff->mode > BUFFER_MODE_STREAM) { $ ERROR_FIELD_DUMP("mode             ", "%u", (unsigned) buff->mode); is_any_invalid = true; }
+    else                                            { $ USUAL_FIELD_DUMP("mode             ", "%s", BUFFER_MODE_NAMES[buff->mode]); }
+
+    if (buff->mode == BUFFER_MODE_STREAM)
+    {
+        if (buff->fd < 0)                    { $ ERROR_FIELD_DUMP ("fd               ", "%d", buff->fd); is_any_invalid = true; }
+        else                                 { $ USUAL_FIELD_DUMP ("fd               ", "%d", buff->fd); }
+
+        if (buff->size > buff->capacity)     { $ ERROR_FIELD_DUMP ("capacity         ", "%lu", buff->capacity); is_any_invalid = true; }
+        else                                 { $ USUAL_FIELD_DUMP ("capacity         ", "%lu", buff->capacity); }
+
+$       USUAL_FIELD_DUMP("is_eof           ", "%s", buff->is_eof ? "true" : "false");
+    }
 
     if       (         rel_pos <          0) { $ ERROR_FIELD_DUMP ("relative position", "%ld", rel_pos); is_any_invalid = true; }
     else if  ((size_t) rel_pos > buff->size) { $ ERROR_FIELD_DUMP ("relative position", "%ld", rel_pos); is_any_invalid = true; }
@@ -4,15 +4,104 @@
 
 #include <stdio.h>
 #include <ctype.h>
+#include <stdarg.h>
+#include <math.h>
+#include <errno.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BUFFER_X86
+#endif
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define BUFFER_SWAR
+#endif
+
 #include "buffer.h"
+#include "buffer_pow5.h"
 #include "log.h"
 
 //================================================================================================================================
 
+const size_t DEFAULT_BUFFER_CAPACITY   = 64;
+const size_t DEFAULT_BUFFER_CHUNK_SIZE = 1UL << 16;
+
+static const size_t BUFFER_U64_MAX_LEN    = 20; ///< длина десятичной записи UINT64_MAX
+static const size_t BUFFER_DOUBLE_MAX_LEN = 32; ///< с запасом больше длины "%.17g" любого double ("-1.2345678901234567e-308")
+
+/**
+*   @brief Двузначные числа 00..99 подряд: для записи числа по две цифры за шаг.
+*/
+static const char BUFFER_DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char BUFFER_EOL_CHARS[] = {'\n', '\0'}; ///< символы, на которых заканчивается строка
+
+static const size_t   BUFFER_MANTISSA_MAX_DIGITS = 19;                  ///< столько значащих цифр всегда помещается в uint64_t
+static const uint64_t BUFFER_MANTISSA_MIN_FULL   = 1000000000000000000; ///< наименьшее 19-значное число
+static const int64_t  BUFFER_EXP_MAX_DIGITS_VAL  = 0x10000;             ///< дальше экспонента не накапливается (все равно 0 или бесконечность)
+
+static const size_t   BUFFER_FALLBACK_LOCAL_SIZE = 64;  ///< запись числа для strtod короче этого собирается на стеке
+
+static const unsigned BUFFER_DOUBLE_MANTISSA_BITS = 52;     ///< явные биты мантиссы double
+static const int64_t  BUFFER_DOUBLE_MIN_EXP       = -1023;  ///< смещение экспоненты double со знаком минус
+static const int64_t  BUFFER_DOUBLE_INF_POWER     = 0x7FF;  ///< экспонента бесконечности
+static const int64_t  BUFFER_EXACT_MIN_EXP10      = -22;    ///< степени 10 в [-22, 22] и мантиссы до 2^53 - точные double
+static const int64_t  BUFFER_EXACT_MAX_EXP10      =  22;
+static const int64_t  BUFFER_ROUND_EVEN_MIN_EXP10 = -4;     ///< только при таких степенях 10 возможна точная середина между double
+static const int64_t  BUFFER_ROUND_EVEN_MAX_EXP10 =  23;
+
+/**
+*   @brief Степени 10, точно представимые в uint64_t: для дописывания 1..8 цифр к числу.
+*/
+static const uint64_t BUFFER_POW10_U64[] =
+{
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+};
+
+/**
+*   @brief Степени 10, точно представимые в double.
+*/
+static const double BUFFER_POW10_DOUBLE[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/**
+*   @brief Разобранная десятичная запись вещественного числа: mantissa * 10^exp10.
+*/
+struct buffer_decimal
+{
+    uint64_t mantissa;      ///< первые (не больше 19) значащих цифр
+    int64_t  exp10;         ///< степень 10
+    bool     is_negative;   ///< есть ли минус
+    bool     is_truncated;  ///< в записи больше 19 значащих цифр, mantissa - их начало
+
+    const char *int_beg;    ///< начало целой части
+    const char *int_end;    ///< конец целой части
+    const char *frac_beg;   ///< начало дробной части
+    const char *frac_end;   ///< конец дробной части
+    int64_t     exp_number; ///< значение записанной экспоненты (0, если ее нет)
+};
+
+//================================================================================================================================
+
 /**
 *   @brief Типы ошибок в буфере.
 */
@@ -30,6 +119,9 @@ typedef enum
 
     BUFF_POS_LESS_BEG   ,   ///< .pos <  .beg
     BUFF_POS_MORE_END   ,   ///< .pos >= .beg + .size
+
+    BUFF_INVALID_MODE   ,   ///< .mode - не BUFFER_MODE_TYPE
+    BUFF_INVALID_STREAM ,   ///< у потокового буфера .fd < 0, .size = 0 или .size > .capacity
 }
 BUFF_STATUS_TYPE;
 
@@ -52,6 +144,34 @@ static const char *BUFF_STATUS_MESSAGES[] =
 
     "buffer.pos is less than buffer.beg"    ,
     "buffer.pos is more thna buffer end"    ,
+
+    "buffer.mode is invalid"                ,
+    "buffer stream fields are invalid"      ,
+};
+
+/**
+*   @brief Названия режимов буфера для дампа.
+*
+*   @see enum BUFFER_MODE_TYPE
+*/
+static const char *BUFFER_MODE_NAMES[] =
+{
+    "fixed"   ,
+    "mapped"  ,
+    "growable",
+    "stream"  ,
+};
+
+/**
+*   @brief Значения advice для madvise() по типу доступа.
+*
+*   @see enum BUFFER_ACCESS_TYPE
+*/
+static const int BUFFER_MADVISE[] =
+{
+    MADV_NORMAL    ,
+    MADV_SEQUENTIAL,
+    MADV_RANDOM    ,
 };
 
 /**
@@ -62,6 +182,14 @@ static const buffer BUFF_POISON =
     .beg  = (char *) 0xDEADBEEF,
     .pos  = (char *) 0xABADBABE,
     .size =          0xABADB002,
+
+    .alc  = (allocator *) 0xDEFEC8ED,
+    .mode = BUFFER_MODE_FIXED,
+
+    .fd          = -1,
+    .capacity    = 0xBAADF00D,
+    .is_eof      = false,
+    .is_fd_owned = false,
 };
 
 //================================================================================================================================
@@ -70,6 +198,32 @@ static void     buffer_log_error          (const buffer *const buff, const unsig
 static unsigned buffer_fields_verify      (const buffer *const buff);
 
 static bool     get_file_size             (const char *file_name, size_t *const file_size);
+static size_t   buffer_map_size           (const size_t size);
+static bool     buffer_grow               (buffer *const buff, const size_t data_size);
+static void     buffer_stream_fields_init (buffer *const buff);
+static bool     buffer_is_writable        (const buffer *const buff);
+
+static bool     buffer_is_data_end        (const buffer *const buff, const char *const cur);
+static bool     buffer_stream_more        (buffer *const buff, char **const cur);
+static char     buffer_peek               (buffer *const buff, const size_t offset);
+static char    *buffer_find_eol           (char *cur, const char *const limit);
+static char    *buffer_find_delim         (char *cur, const char *const limit, const buffer_delims *const delims);
+#ifdef BUFFER_X86
+static char    *buffer_find_chars_sse2    (char *cur, const char *const limit, const char *const chars, const size_t chars_count);
+#endif
+
+static char     buffer_skip_spaces        (buffer *const buff);
+static bool     buffer_is_space           (const char c);
+static bool     buffer_read_digits        (buffer *const buff, const size_t sign_len, uint64_t *const val, bool *const is_overflow);
+static char    *buffer_parse_digits       (char *cur, const char *const limit, uint64_t *const val, bool *const is_overflow);
+#ifdef BUFFER_SWAR
+static size_t   buffer_swar_digit_count   (const uint64_t chunk);
+static uint64_t buffer_swar_digits_value  (const uint64_t chunk, const size_t digit_count);
+#endif
+static char    *buffer_parse_decimal      (char *const cur, const char *const limit, buffer_decimal *const dec, char **const stop);
+static double   buffer_decimal_to_double  (const buffer_decimal *const dec);
+static uint64_t buffer_eisel_lemire       (const int64_t exp10, uint64_t mantissa);
+static bool     buffer_decimal_strtod     (const buffer_decimal *const dec, double *const res);
 
 static void     buffer_static_dump        (const buffer *const buff, const bool is_full);
 static bool     buffer_header_dump        (const buffer *const buff);
@@ -1,74 +1,72 @@
 #include "cache_list_static.h"
 
-//--------------------------------------------------------------------------------------------------------------------------------
-// list verify
-//--------------------------------------------------------------------------------------------------------------------------------
+//================================================================================================================================
 
-unsigned _cache_list_verify(const list *const lst)
+unsigned cache_list_verify(const cache_list *const lst)
 {
 $i
-    unsigned err = LST_OK;
+    unsigned err = CACHE_LST_OK;
 
     if (lst == nullptr)
     {
-        err = (1 << LST_NULLPTR);
-$       list_log_error(lst, err);
+        err = (1 << CACHE_LST_NULLPTR);
+$       cache_list_log_error(lst, err);
 $o      return err;
     }
 
-$   err = err | list_poison_verify(lst);
-$   err = err | list_fields_verify(lst);
-
-$   if (err != LST_OK) { list_log_error(lst, err); $o return err; }
+$   err = cache_list_poison_verify(lst);
+$   err = cache_list_fields_verify(lst) | err;
 
-$   err = err | list_free_cycle_verify(lst);
-$   err = err | list_busy_cycle_verify(lst);
+$   if (err == CACHE_LST_OK) err = cache_list_free_cycle_verify(lst);
+$   if (err == CACHE_LST_OK) err = cache_list_busy_cycle_verify(lst);
+$   if (err == CACHE_LST_OK) err = cache_list_linearized_verify(lst);
 
-$   list_log_error(lst, err);
+$   cache_list_log_error(lst, err);
 $o  return err;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static void list_log_error(const list *const lst, const unsigned err)
+static void cache_list_log_error(const cache_list *const lst, const unsigned err)
 {
 $i
-    if (err == LST_OK) { $o return; }
+    if (err == CACHE_LST_OK) { $o return; }
 
-$   log_error("cache_list verify failed\n");
+$   LOG_ERROR("cache_list verify failed\n");
 
-$   for (size_t i = 1; i * sizeof(char *) < sizeof(LST_STATUS_MESSAGES); ++i)
+$   for (size_t i = 1; i * sizeof(char *) < sizeof(CACHE_LST_STATUS_MESSAGES); ++i)
     {
-        if (err & (1 << i)) log_tab_error_message("%s", "\n", LST_STATUS_MESSAGES[i]);
+        if (err & (1 << i))
+            LOG_TAB_ERROR_MESSAGE("%s", "\n", CACHE_LST_STATUS_MESSAGES[i]);
     }
 
-$   log_message("\n");
-
-$   list_static_dump(lst, true);
-
-$   log_tab_error_message("====================", "\n");
-$   log_message("\n");
+$   LOG_MESSAGE("\n");
+$   cache_list_static_dump(lst, true);
+$   LOG_TAB_ERROR_MESSAGE(BOLD_LOG_SEP, "\n");
 $o
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static unsigned list_poison_verify(const list *const lst)
+static unsigned cache_list_poison_verify(const cache_list *const lst)
 {
 $i
-    log_assert(lst != nullptr);
+    LOG_ASSERT(lst != nullptr);
 
-    unsigned err = LST_OK;
+    unsigned err = CACHE_LST_OK;
 
-    #define poison_verify(lst_field, err_field)   \
-    if (lst->lst_field == LST_POISON.lst_field) err = err | (1 << err_field);
+    #define poison_verify(field, status) \
+    if (lst->field == CACHE_LST_POISON.field) err |= (1 << status);
 
-    poison_verify(fictional, LST_POISON_FICTIONAL)
-    poison_verify(data     , LST_POISON_DATA     )
-    poison_verify(el_free  , LST_POISON_EL_FREE  )
-    poison_verify(el_size  , LST_POISON_EL_SIZE  )
-    poison_verify(el_dtor  , LST_POISON_EL_DTOR  )
-    poison_verify(el_dump  , LST_POISON_EL_DUMP  )
+    poison_verify(fictional, CACHE_LST_POISON_FICTIONAL)
+    poison_verify(data     , CACHE_LST_POISON_DATA     )
+    poison_verify(busy     , CACHE_LST_POISON_BUSY     )
+    poison_verify(size     , CACHE_LST_POISON_SIZE     )
+    poison_verify(capacity , CACHE_LST_POISON_CAPACITY )
+    poison_verify(el_free  , CACHE_LST_POISON_EL_FREE  )
+    poison_verify(el_size  , CACHE_LST_POISON_EL_SIZE  )
+    poison_verify(el_dtor  , CACHE_LST_POISON_EL_DTOR  )
+    poison_verify(el_dump  , CACHE_LST_POISON_EL_DUMP  )
 
     #undef poison_verify
 
@@ -77,393 +75,471 @@ $o  return err;
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static unsigned list_fields_verify(const list *const lst)
+static unsigned cache_list_fields_verify(const cache_list *const lst)
 {
 $i
-    log_assert(lst != nullptr);
+    LOG_ASSERT(lst != nullptr);
 
-    unsigned err = LST_OK;
+    unsigned err = CACHE_LST_OK;
 
-    if ($fictional == nullptr) err = err | (1 << LST_NULLPTR_FICTIONAL);
-    if ($data      == nullptr) err = err | (1 << LST_NULLPTR_DATA     );
-    if ($capacity  <= $size  ) err = err | (1 << LST_INVALID_SIZE_CAPACITY);
-    if ($el_free >  $capacity) err = err | (1 << LST_INVALID_EL_FREE  );
+    if (lst->fictional == nullptr      ) err |= (1 << CACHE_LST_NULLPTR_FICTIONAL);
+    if (lst->data      == nullptr      ) err |= (1 << CACHE_LST_NULLPTR_DATA);
+    if (lst->busy      == nullptr      ) err |= (1 << CACHE_LST_NULLPTR_BUSY);
+    if (lst->capacity  <= lst->size    ) err |= (1 << CACHE_LST_INVALID_SIZE_CAPACITY);
+    if (lst->el_free   >  lst->capacity) err |= (1 << CACHE_LST_INVALID_EL_FREE);
 
 $o  return err;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-#define list_free_node_verify(node) if ((err = _list_node_verify(lst, node, false)) != LST_OK) { $o return err; }
+#define cache_list_free_node_verify(node) if ((err = cache_list_node_verify(lst, node, false)) != CACHE_LST_OK) { $o return err; }
+#define cache_list_busy_node_verify(node) if ((err = cache_list_node_verify(lst, node, true )) != CACHE_LST_OK) { $o return err; }
 
-static unsigned list_free_cycle_verify(const list *const lst)
+static unsigned cache_list_free_cycle_verify(const cache_list *const lst)
 {
 $i
-    log_assert(lst        != nullptr);
-    log_assert($fictional != nullptr);
-    log_assert($capacity  >    $size);
+    LOG_ASSERT(lst            != nullptr);
+    LOG_ASSERT(lst->fictional != nullptr);
+    LOG_ASSERT(lst->capacity  >  lst->size);
 
-    unsigned err = LST_OK;
+    unsigned err = CACHE_LST_OK;
 
-    const size_t free_cycle_len = $capacity - ($size + 1);
-    if (free_cycle_len == 0) { $o return $el_free == $capacity ? LST_OK : (1 << LST_INVALID_EL_FREE); }
+    const size_t free_cycle_len = lst->capacity - (lst->size + 1);
+    if (free_cycle_len == 0) { $o return (lst->el_free == lst->capacity) ? CACHE_LST_OK : (1 << CACHE_LST_INVALID_EL_FREE); }
+    if (lst->el_free   == 0 || lst->el_free == lst->capacity) { $o return 1 << CACHE_LST_INVALID_EL_FREE; }
 
-    list_node *const node_free_first = $fictional + $el_free;
+    const cache_list_node *const node_free_first = lst->fictional + lst->el_free;
 
-$   list_node *node_cur  = node_free_first;             list_free_node_verify(node_cur );
-$   list_node *node_next = $fictional + node_cur->next; list_free_node_verify(node_next);
+$   const cache_list_node *node_cur  = node_free_first;                  cache_list_free_node_verify(node_cur );
+$   const cache_list_node *node_next = lst->fictional + node_cur->next;  cache_list_free_node_verify(node_next);
 
     for (size_t i = 1; i < free_cycle_len; ++i)
     {
-        if (node_next->prev != (size_t) (node_cur - $fictional)) { $o return (1 << LST_INVALID_CYCLE); }
-        if (node_next == node_free_first)                        { $o return (1 << LST_INVALID_CYCLE); }
+        if (node_next->prev != (size_t) (node_cur - lst->fictional)) { $o return 1 << CACHE_LST_INVALID_CYCLE; }
+        if (node_next == node_free_first)                            { $o return 1 << CACHE_LST_INVALID_CYCLE; }
 
         node_cur  = node_next;
-        node_next = $fictional + node_cur->next;
-
-$       list_free_node_verify(node_next);
+        node_next = lst->fictional + node_cur->next;
+$       cache_list_free_node_verify(node_next);
     }
 
-    if (node_next->prev != (size_t) (node_cur - $fictional)) { $o return (1 << LST_INVALID_CYCLE); }
-    if (node_next != node_free_first)                        { $o return (1 << LST_INVALID_CYCLE); }
+    if (node_next->prev != (size_t) (node_cur - lst->fictional)) { $o return 1 << CACHE_LST_INVALID_CYCLE; }
+    if (node_next != node_free_first)                            { $o return 1 << CACHE_LST_INVALID_CYCLE; }
 
-$o  return LST_OK;
+$o  return CACHE_LST_OK;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-#define list_busy_node_verify(node) if ((err = _list_node_verify(lst, node, true)) != LST_OK) { $o return err; }
-
-static unsigned list_busy_cycle_verify(const list *const lst)
+static unsigned cache_list_busy_cycle_verify(const cache_list *const lst)
 {
 $i
-    log_assert(lst        != nullptr);
-    log_assert($fictional != nullptr);
-    log_assert($capacity  >    $size);
-
-    unsigned err = LST_OK;
+    LOG_ASSERT(lst            != nullptr);
+    LOG_ASSERT(lst->fictional != nullptr);
+    LOG_ASSERT(lst->capacity  >  lst->size);
 
-    const size_t busy_cycle_len = $size + 1;
+    unsigned err = CACHE_LST_OK;
 
-    list_node *node_cur  = $fictional;
-    list_node *node_next = $fictional + node_cur->next;
+    const cache_list_node *node_cur  = lst->fictional;
+    const cache_list_node *node_next = lst->fictional + node_cur->next;
 
-    /* fictional */   $ list_free_node_verify(node_cur );
-    if ($size == 0) { $ list_free_node_verify(node_next); }
-    else            { $ list_busy_node_verify(node_next); }
+    /* fictional */       $ cache_list_free_node_verify(node_cur );
+    if (lst->size == 0) { $ cache_list_free_node_verify(node_next); }
+    else                { $ cache_list_busy_node_verify(node_next); }
 
-    for (size_t i = 1; i < busy_cycle_len; ++i)
+    for (size_t i = 1; i <= lst->size; ++i)
     {
-        if (node_next->prev != (size_t) (node_cur - $fictional)) { $o return (1 << LST_INVALID_CYCLE); }
-        if (node_next == $fictional)                             { $o return (1 << LST_INVALID_CYCLE); }
+        if (node_next->prev != (size_t) (node_cur - lst->fictional)) { $o return 1 << CACHE_LST_INVALID_CYCLE; }
+        if (node_next == lst->fictional)                             { $o return 1 << CACHE_LST_INVALID_CYCLE; }
 
         node_cur  = node_next;
-        node_next = $fictional + node_cur->next;
-
-$       if (i != busy_cycle_len - 1) list_busy_node_verify(node_next);
+        node_next = lst->fictional + node_cur->next;
+$       if (i != lst->size) cache_list_busy_node_verify(node_next);
     }
 
-    if (node_next->prev != (size_t) (node_cur - $fictional)) { $o return (1 << LST_INVALID_CYCLE); }
-    if (node_next != $fictional)                             { $o return (1 << LST_INVALID_CYCLE); }
+    if (node_next->prev != (size_t) (node_cur - lst->fictional)) { $o return 1 << CACHE_LST_INVALID_CYCLE; }
+    if (node_next != lst->fictional)                             { $o return 1 << CACHE_LST_INVALID_CYCLE; }
 
-$o  return LST_OK;
+$o  return CACHE_LST_OK;
 }
 
-#undef list_free_node_verify
-#undef list_busy_node_verify
+#undef cache_list_free_node_verify
+#undef cache_list_busy_node_verify
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static unsigned _list_node_verify(const list *const lst, const list_node *const lst_node, const bool is_busy)
+static unsigned cache_list_linearized_verify(const cache_list *const lst)
 {
 $i
-    log_assert(lst      != nullptr);
-    log_assert(lst_node != nullptr);
+    LOG_ASSERT(lst            != nullptr);
+    LOG_ASSERT(lst->fictional != nullptr);
+
+    if (!lst->is_linearized) { $o return CACHE_LST_OK; }
 
-    if ($is_busy != is_busy) { $o return 1 << LST_INVALID_CYCLE; }
-    if ($next   > $capacity) { $o return 1 << LST_INVALID_CYCLE; }
-    if ($prev   > $capacity) { $o return 1 << LST_INVALID_CYCLE; }
+    for (size_t ind = 0; ind <= lst->size; ++ind)
+    {
+        const size_t ind_next = (ind == lst->size) ? 0 : ind + 1;
+        if (lst->fictional[ind].next != ind_next) { $o return 1 << CACHE_LST_INVALID_LINEARIZED; }
+    }
 
-$o  return LST_OK;
+$o  return CACHE_LST_OK;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
-// ctor
-//--------------------------------------------------------------------------------------------------------------------------------
 
-bool cache_list_ctor(cache_list *const lst, const size_t el_size,
+static unsigned cache_list_node_verify(const cache_list *const lst, const cache_list_node *const lst_node, const bool is_busy)
+{
+$i
+    LOG_ASSERT(lst      != nullptr);
+    LOG_ASSERT(lst_node != nullptr);
+
+    const size_t ind = (size_t) (lst_node - lst->fictional);
+
+    if (cache_list_is_busy(lst, ind) != is_busy) { $o return 1 << CACHE_LST_INVALID_CYCLE; }
+    if (lst_node->next >= lst->capacity)         { $o return 1 << CACHE_LST_INVALID_CYCLE; }
+    if (lst_node->prev >= lst->capacity)         { $o return 1 << CACHE_LST_INVALID_CYCLE; }
 
-                                            void (*el_dtor) (      void *const) /* = nullptr */,
-                                            void (*el_dump) (const void *const) /* = nullptr */,
+$o  return CACHE_LST_OK;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
 
-                                            const size_t list_capacity /* = DEFAULT_CACHE_LIST_CAPACITY */)
+bool cache_list_ctor(cache_list *const lst, const size_t el_size, void (*el_dtor) (      void *const) /* = nullptr */,
+                                                                  void (*el_dump) (const void *const) /* = nullptr */,
+                                                                  const size_t list_capacity          /* = DEFAULT_CACHE_LIST_CAPACITY */)
 {
 $i
-    log_verify(lst    != nullptr, false);
-    log_verify(list_capacity > 1, false);
-    log_verify(el_size  > 0UL   , false);
+    LOG_VERIFY(lst != nullptr    , false);
+    LOG_VERIFY(list_capacity > 1 , false);
+    LOG_VERIFY(list_capacity <= CACHE_LIST_MAX_CAPACITY, false);
+    LOG_VERIFY(el_size > 0UL     , false);
 
-    $el_dtor  = el_dtor;
-    $el_dump  = el_dump;
+    lst->size     = 0;
+    lst->capacity = list_capacity;
 
-    $size     = 0;
-    $capacity = list_capacity;
+    lst->el_free  = 1;
+    lst->el_size  = el_size;
 
-    $el_size  = el_size;
-    $el_free  = 1;
+    lst->el_dtor  = el_dtor;
+    lst->el_dump  = el_dump;
 
-$   if (!list_data_ctor(lst)) { $o return false; }
+    lst->is_linearized = true;
 
-$   cache_lst_debug_verify(lst);
+$   if (!cache_list_data_ctor(lst)) { $o return false; }
+
+$   CACHE_LIST_ASSERT(lst);
 $o  return true;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-cache_list *cache_list_new(const size_t el_size,
-
-                           void (*el_dtor) (      void *const) /* = nullptr */,
-                           void (*el_dump) (const void *const) /* = nullptr */,
-
-                           const size_t list_capacity /* = DEFAULT_CACHE_LIST_CAPACITY */)
+cache_list *cache_list_new(const size_t el_size, void (*el_dtor) (      void *const) /* = nullptr */,
+                                                 void (*el_dump) (const void *const) /* = nullptr */,
+                                                 const size_t list_capacity          /* = DEFAULT_CACHE_LIST_CAPACITY */)
 {
 $i
-$   list *lst = (list *) log_calloc(1, sizeof(list));
+$   cache_list *lst = (cache_list *) LOG_CALLOC(1, sizeof(cache_list));
     if (lst == nullptr)
     {
-$       log_error("log_calloc(1, sizeof(list) = %lu) returns nullptr\n", sizeof(list));
+$       LOG_ERROR("log_calloc(1, sizeof(cache_list) = %lu) returns nullptr\n", sizeof(cache_list));
+$o      return nullptr;
+    }
+$   if (!cache_list_ctor(lst, el_size, el_dtor, el_dump, list_capacity))
+    {
+        LOG_FREE(lst);
 $o      return nullptr;
     }
 
-$   if (!cache_list_ctor(lst, el_size, el_dtor, el_dump, list_capacity)) { log_free(lst); $o return nullptr; }
-
-$   cache_lst_debug_verify(lst);
+$   CACHE_LIST_ASSERT(lst);
 $o  return lst;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static bool list_data_ctor(list *const lst)
+static bool cache_list_data_ctor(cache_list *const lst)
 {
 $i
-    log_assert(lst != nullptr);
+    LOG_ASSERT(lst != nullptr);
 
-$   $fictional = (list_node *) log_calloc($capacity, sizeof(list_node));
-$   $data      =               log_calloc($capacity, $el_size);
+$   lst->fictional = (cache_list_node *) LOG_CALLOC(lst->capacity, sizeof(cache_list_node));
+    if (lst->fictional == nullptr)
+    {
+$       LOG_ERROR("log_calloc(capacity = %lu, sizeof(cache_list_node) = %lu) returns nullptr\n",
+                              lst->capacity , sizeof(cache_list_node));
+$o      return false;
+    }
 
-    if ($fictional == nullptr)
+$   lst->data = LOG_CALLOC(lst->capacity, lst->el_size);
+    if (lst->data == nullptr)
     {
-$       log_error("log_calloc($capacity = %lu, sizeof(list_node) = %lu) returns nullptr\n",
-                              $capacity      , sizeof(list_node));
+$       LOG_ERROR("log_calloc(capacity = %lu, el_size = %lu) returns nullptr\n",
+                              lst->capacity , lst->el_size);
+$       LOG_FREE(lst->fictional);
 $o      return false;
     }
-    if ($data == nullptr)
+
+$   lst->busy = (uint64_t *) LOG_CALLOC(cache_list_busy_words(lst->capacity), sizeof(uint64_t));
+    if (lst->busy == nullptr)
     {
-$       log_error("log_calloc($capacity = %lu, $el_size = %lu) returns nullptr\n",
-                              $capacity      , $el_size);
+$       LOG_ERROR("log_calloc(busy_words = %lu, sizeof(uint64_t) = %lu) returns nullptr\n",
+                              cache_list_busy_words(lst->capacity), sizeof(uint64_t));
+$       LOG_FREE(lst->fictional);
+$       LOG_FREE(lst->data);
 $o      return false;
     }
 
-$   list_free_node_init (lst, 0 /* fictional */, 0, 0);
-$   list_free_cycle_ctor(lst);
+$   cache_list_free_node_init (lst, 0 /* fictional */, 0, 0);
+$   cache_list_free_cycle_ctor(lst);
 
 $o  return true;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static void list_free_cycle_ctor(list *const lst)
+static void cache_list_free_cycle_ctor(cache_list *const lst)
 {
 $i
-    log_assert(lst        != nullptr);
-    log_assert($fictional != nullptr);
+    LOG_ASSERT(lst            != nullptr);
+    LOG_ASSERT(lst->fictional != nullptr);
+    LOG_ASSERT(lst->el_free   <  lst->capacity);
 
-    const size_t free_node_first_ind = $el_free;
-    const size_t free_node_last_ind  = $capacity - 1;
+    const size_t free_node_first_ind = lst->el_free;
+    const size_t free_node_last_ind  = lst->capacity - 1;
 
 $   for (size_t ind = free_node_first_ind + 1; ind < free_node_last_ind; ++ind)
     {
-        list_free_node_init(lst, ind, ind - 1, ind + 1);
+        cache_list_free_node_init(lst, ind, ind - 1, ind + 1);
     }
 
-$   list_free_node_init(lst, free_node_first_ind, free_node_last_ind, size_t_min(free_node_first_ind + 1, free_node_last_ind));
-$   list_free_node_init(lst, free_node_last_ind , size_t_max(free_node_last_ind - 1, free_node_first_ind), free_node_first_ind);
+    const size_t first_next = (free_node_first_ind < free_node_last_ind) ? free_node_first_ind + 1 : free_node_last_ind;
+    const size_t last_prev  = (free_node_first_ind < free_node_last_ind) ? free_node_last_ind  - 1 : free_node_first_ind;
+
+$   cache_list_free_node_init(lst, free_node_first_ind, free_node_last_ind, first_next);
+$   cache_list_free_node_init(lst, free_node_last_ind , last_prev, free_node_first_ind);
 $o
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static void list_free_node_init(list *const lst, const size_t ind_cur ,
-                                                 const size_t ind_prev,
-                                                 const size_t ind_next)
+static void cache_list_free_node_init(cache_list *const lst, const size_t ind_cur ,
+                                                             const size_t ind_prev,
+                                                             const size_t ind_next)
 {
-$i
-    log_assert(lst        != nullptr);
-    log_assert($fictional != nullptr);
+    LOG_ASSERT(lst            != nullptr);
+    LOG_ASSERT(lst->fictional != nullptr);
 
-    log_assert(ind_cur  < $capacity);
-    log_assert(ind_prev < $capacity);
-    log_assert(ind_next < $capacity);
+    LOG_ASSERT(ind_cur  < lst->capacity);
+    LOG_ASSERT(ind_prev < lst->capacity);
+    LOG_ASSERT(ind_next < lst->capacity);
 
-    $fictional[ind_cur].is_busy = false;
-    $fictional[ind_cur].prev = ind_prev;
-    $fictional[ind_cur].next = ind_next;
-$o
+    lst->fictional[ind_cur].prev = (cache_list_index) ind_prev;
+    lst->fictional[ind_cur].next = (cache_list_index) ind_next;
+    cache_list_set_busy(lst, ind_cur, false);
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static bool list_free_node_new(list *const lst, const size_t ind_cur, void *const erased_data)
+static inline size_t cache_list_busy_words(const size_t capacity)
 {
-$i
-$   cache_lst_debug_verify(lst);
-
-    log_assert(ind_cur < $capacity);
-    log_assert(ind_cur > 0);
-
-    void       *erased_el = (char *) $data + ind_cur * $el_size;
-    const size_t ind_prev = $fictional[ind_cur].prev;
-    const size_t ind_next = $fictional[ind_cur].next;
-
-    $fictional[ind_prev].next = ind_next;
-    $fictional[ind_next].prev = ind_prev;
+    return (capacity + CACHE_LIST_BUSY_WORD_BITS - 1) / CACHE_LIST_BUSY_WORD_BITS;
+}
 
-    if ($el_free == $capacity) { $ list_free_node_init(lst, ind_cur, ind_cur, ind_cur); }
-    else                       { $ list_free_node_ctor(lst, ind_cur, $el_free, $fictional[$el_free].prev); }
-    $el_free = ind_cur;
+static inline bool cache_list_is_busy(const cache_list *const lst, const size_t ind)
+{
+    return (lst->busy[ind / CACHE_LIST_BUSY_WORD_BITS] >> (ind % CACHE_LIST_BUSY_WORD_BITS)) & 1;
+}
 
-    if (erased_data != nullptr) memcpy(erased_data, erased_el, $el_size);
-    if ($el_dtor    != nullptr) { $ $el_dtor(erased_el); }
+static inline void cache_list_set_busy(cache_list *const lst, const size_t ind, const bool is_busy)
+{
+    const uint64_t mask = 1UL << (ind % CACHE_LIST_BUSY_WORD_BITS);
 
-$   cache_lst_debug_verify(lst);
-$o  return true;
+    if (is_busy) lst->busy[ind / CACHE_LIST_BUSY_WORD_BITS] |=  mask;
+    else         lst->busy[ind / CACHE_LIST_BUSY_WORD_BITS] &= ~mask;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static void list_free_node_ctor(list *const lst, const size_t ind_cur,
-                                                 const size_t ind_next,
-                                                 const size_t ind_prev)
+static void cache_list_free_node_new(cache_list *const lst, const size_t ind_cur, void *const erased_data)
 {
 $i
-    log_assert(lst        != nullptr);
-    log_assert($fictional != nullptr);
+$   CACHE_LIST_ASSERT(lst);
+    LOG_ASSERT(ind_cur > 0);
+    LOG_ASSERT(ind_cur < lst->capacity);
+    LOG_ASSERT(cache_list_is_busy(lst, ind_cur));
+
+    cache_list_node *const nodes = lst->fictional;
+    void            *erased_el   = (char *) lst->data + ind_cur * lst->el_size;
+
+    nodes[nodes[ind_cur].prev].next = nodes[ind_cur].next;
+    nodes[nodes[ind_cur].next].prev = nodes[ind_cur].prev;
 
-    log_assert(ind_cur != 0);
-    log_assert(ind_cur  < $capacity);
-    log_assert(ind_next < $capacity);
-    log_assert(ind_prev < $capacity);
+    if (lst->el_free == lst->capacity) { cache_list_free_node_init(lst, ind_cur, ind_cur, ind_cur); }
+    else
+    {
+        const size_t ind_next = lst->el_free;
+        const size_t ind_prev = nodes[ind_next].prev;
 
-    list_node *lst_node = $fictional + ind_cur;
+        cache_list_free_node_init(lst, ind_cur, ind_prev, ind_next);
+        nodes[ind_prev].next = (cache_list_index) ind_cur;
+        nodes[ind_next].prev = (cache_list_index) ind_cur;
+    }
+    lst->el_free = ind_cur;
+    lst->is_linearized = lst->is_linearized && ind_cur == lst->size; // pop_back сохраняет линеаризованность
+    lst->size--;
 
-    $is_busy = false;
-    $next = ind_next; $fictional[ind_next].prev = ind_cur;
-    $prev = ind_prev; $fictional[ind_prev].next = ind_cur;
+    if (erased_data  != nullptr) memcpy(erased_data, erased_el, lst->el_size);
+    if (lst->el_dtor != nullptr) { $ lst->el_dtor(erased_el); }
 
-    $size--;
+$   CACHE_LIST_ASSERT(lst);
 $o
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static bool list_busy_node_new(list *const lst, const void *const data, const size_t ind_prev,
-                                                                        const size_t ind_next)
+static bool cache_list_busy_node_new(cache_list *const lst, const void *const data, const size_t ind_prev,
+                                                                                    const size_t ind_next)
 {
 $i
-$   cache_lst_debug_verify(lst);
-    log_assert(data != nullptr);
+$   CACHE_LIST_ASSERT(lst);
+    LOG_ASSERT(data != nullptr);
 
-    log_assert(ind_prev < $capacity);
-    log_assert(ind_next < $capacity);
+    LOG_ASSERT(ind_prev < lst->capacity);
+    LOG_ASSERT(ind_next < lst->capacity);
 
-$   if ($size + 1 == $capacity) if (!list_resize(lst)) { $o return false; }
+$   if (!cache_list_grow(lst, lst->size + 1)) { $o return false; }
 
-    const size_t ind_cur = $el_free;
+    const size_t ind_cur = lst->el_free;
+    lst->is_linearized   = lst->is_linearized && ind_next == 0 && ind_cur == lst->size + 1; // push_back сохраняет линеаризованность
 
-    if ($capacity - $size == 2) $el_free = $capacity;
+    if (lst->capacity - lst->size == 2) lst->el_free = lst->capacity;
     else
     {
-        size_t free_next = $fictional[$el_free].next;
-        size_t free_prev = $fictional[$el_free].prev;
+        const size_t free_next = lst->fictional[ind_cur].next;
+        const size_t free_prev = lst->fictional[ind_cur].prev;
 
-        $fictional[free_next].prev = free_prev;
-        $fictional[free_prev].next = free_next;
+        lst->fictional[free_next].prev = (cache_list_index) free_prev;
+        lst->fictional[free_prev].next = (cache_list_index) free_next;
 
-        $el_free = free_next;
+        lst->el_free = free_next;
     }
 
-$   list_busy_node_ctor(lst, data, ind_cur, ind_prev, ind_next);
+$   cache_list_busy_node_ctor(lst, data, ind_cur, ind_prev, ind_next);
+
 $o  return true;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static void list_busy_node_ctor(list *const lst, const void *const data, const size_t ind_cur,
-                                                                         const size_t ind_prev,
-                                                                         const size_t ind_next)
+static void cache_list_busy_node_ctor(cache_list *const lst, const void *const data, const size_t ind_cur,
+                                                                                     const size_t ind_prev,
+                                                                                     const size_t ind_next)
 {
 $i
-    cache_lst_debug_verify(lst);
-    log_assert(data != nullptr);
+    LOG_ASSERT(lst  != nullptr);
+    LOG_ASSERT(data != nullptr);
 
-    log_assert(ind_cur != 0);
-    log_assert(ind_cur  < $capacity);
-    log_assert(ind_prev < $capacity);
-    log_assert(ind_next < $capacity);
+    LOG_ASSERT(ind_cur != 0);
+    LOG_ASSERT(ind_cur  < lst->capacity);
+    LOG_ASSERT(ind_prev < lst->capacity);
+    LOG_ASSERT(ind_next < lst->capacity);
 
-    list_node *lst_node = $fictional + ind_cur;
+    cache_list_node *const nodes = lst->fictional;
 
-    $is_busy = true;
-    $next = ind_next; $fictional[ind_next].prev = ind_cur;
-    $prev = ind_prev; $fictional[ind_prev].next = ind_cur;
+    nodes[ind_cur].next = (cache_list_index) ind_next; nodes[ind_next].prev = (cache_list_index) ind_cur;
+    nodes[ind_cur].prev = (cache_list_index) ind_prev; nodes[ind_prev].next = (cache_list_index) ind_cur;
+    cache_list_set_busy(lst, ind_cur, true);
 
-    void *ind_data = (char *) $data + ind_cur * $el_size;
-    memcpy (ind_data, data, $el_size);
+$   memcpy((char *) lst->data + ind_cur * lst->el_size, data, lst->el_size);
 
-    $size++;
+    lst->size++;
 $o
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static bool list_resize(list *const lst)
+static bool cache_list_grow(cache_list *const lst, const size_t el_count)
 {
 $i
-$   cache_lst_debug_verify(lst);
-    log_assert($size + 1 == $capacity);
+    LOG_ASSERT(lst != nullptr);
+
+    if (el_count < lst->capacity) { $o return true; }
 
-    size_t capacity_new = 2 * $capacity;
+    if (el_count >= CACHE_LIST_MAX_CAPACITY)
+    {
+$       LOG_ERROR("cache_list capacity can't exceed CACHE_LIST_MAX_CAPACITY = %lu\n", CACHE_LIST_MAX_CAPACITY);
+$o      return false;
+    }
+
+    size_t capacity_new = (lst->capacity > CACHE_LIST_MAX_CAPACITY / 2) ? CACHE_LIST_MAX_CAPACITY : 2 * lst->capacity;
+    if    (capacity_new <= el_count) capacity_new = el_count + 1;
+
+$   bool   ret = cache_list_resize(lst, capacity_new);
+$o  return ret;
+}
 
-$   list_node *fictional_new = (list_node *) log_realloc($fictional, capacity_new * sizeof(list_node));
-$   void      *     data_new =               log_realloc($data     , capacity_new * $el_size);
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static bool cache_list_resize(cache_list *const lst, const size_t capacity_new)
+{
+$i
+$   CACHE_LIST_ASSERT(lst);
+    LOG_ASSERT(capacity_new >  lst->capacity);
+    LOG_ASSERT(capacity_new <= CACHE_LIST_MAX_CAPACITY);
 
+$   cache_list_node *fictional_new = (cache_list_node *) LOG_REALLOC(lst->fictional, capacity_new * sizeof(cache_list_node));
     if (fictional_new == nullptr)
     {
-$       log_error("log_realloc($fictional, (capacity_new * sizeof(list_node)) = %lu) returns nullptr\n",
-                                            capacity_new * sizeof(list_node));
+$       LOG_ERROR("log_realloc(fictional, capacity_new * sizeof(cache_list_node) = %lu) returns nullptr\n",
+                                          capacity_new * sizeof(cache_list_node));
 $o      return false;
     }
+    lst->fictional = fictional_new;
+
+$   void *data_new = LOG_REALLOC(lst->data, capacity_new * lst->el_size);
     if (data_new == nullptr)
     {
-$       log_error("log_realloc($data, (capacity_new * $el_size) = %lu) returns nullptr\n",
-                                       capacity_new * $el_size);
+$       LOG_ERROR("log_realloc(data, capacity_new * el_size = %lu) returns nullptr\n",
+                                     capacity_new * lst->el_size);
 $o      return false;
     }
+    lst->data = data_new;
 
-    $fictional = fictional_new;
-    $data      =      data_new;
+$   uint64_t *busy_new = (uint64_t *) LOG_RECALLOC(lst->busy, cache_list_busy_words(lst->capacity) * sizeof(uint64_t),
+                                                              cache_list_busy_words(capacity_new)  * sizeof(uint64_t));
+    if (busy_new == nullptr)
+    {
+$       LOG_ERROR("log_recalloc(busy, new_size = %lu) returns nullptr\n",
+                                      cache_list_busy_words(capacity_new) * sizeof(uint64_t));
+$o      return false;
+    }
+    lst->busy = busy_new;
 
-    $capacity *= 2;
-    $el_free   = $size + 1;
+    const size_t capacity_old = lst->capacity;
+    lst->capacity = capacity_new;
 
-$   list_free_cycle_ctor  (lst);
-$   cache_lst_debug_verify(lst);
+    if (lst->el_free == capacity_old) { $ cache_list_free_cycle_ctor(lst); }
+    else
+    {
+        // новые слоты дописываются в конец цикла свободных вершин
+        const size_t free_first = lst->el_free;
+        const size_t free_last  = lst->fictional[free_first].prev;
+
+$       for (size_t ind = capacity_old; ind < capacity_new; ++ind)
+        {
+            const size_t ind_prev = (ind == capacity_old    ) ? free_last  : ind - 1;
+            const size_t ind_next = (ind == capacity_new - 1) ? free_first : ind + 1;
+
+            cache_list_free_node_init(lst, ind, ind_prev, ind_next);
+        }
+        lst->fictional[free_last ].next = (cache_list_index)  capacity_old;
+        lst->fictional[free_first].prev = (cache_list_index) (capacity_new - 1);
+    }
 
+$   CACHE_LIST_ASSERT(lst);
 $o  return true;
 }
 
-//--------------------------------------------------------------------------------------------------------------------------------
-// dtor
 //--------------------------------------------------------------------------------------------------------------------------------
 
 void cache_list_dtor(void *const _lst)
@@ -471,42 +547,74 @@ void cache_list_dtor(void *const _lst)
 $i
     if (_lst == nullptr) { $o return; }
 
-    list *const lst = (list *) _lst;
-$   cache_lst_verify(lst, (void) 0);
+    cache_list *const lst = (cache_list *) _lst;
+$   CACHE_LIST_VERIFY(lst, (void) 0);
+
+    if (lst->el_dtor != nullptr)
+    {
+$       for (size_t ind = lst->fictional->next; ind != 0; ind = lst->fictional[ind].next)
+            lst->el_dtor((char *) lst->data + ind * lst->el_size);
+    }
 
-$   log_free($fictional);
-$   log_free($data);
+$   LOG_FREE(lst->fictional);
+$   LOG_FREE(lst->data);
+$   LOG_FREE(lst->busy);
 
-    *lst = LST_POISON;
+    *lst = CACHE_LST_POISON;
 $o
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-void cache_list_free(void *const _lst)
+void cache_list_delete(void *const _lst)
 {
 $i
 $   cache_list_dtor(_lst);
-$   log_free       (_lst);
+$   LOG_FREE       (_lst);
 $o
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
-// insert erase
+
+static size_t cache_list_get_node_index(const cache_list *const lst, const size_t pos)
+{
+$i
+$   CACHE_LIST_ASSERT(lst);
+    LOG_ASSERT(pos <= lst->size);
+
+    if (lst->is_linearized) { $o return (pos == lst->size) ? 0 : pos + 1; }
+
+    size_t cur_ind = 0;
+
+    if (2 * pos <= lst->size) { for (size_t i =         0; i <= pos; ++i) cur_ind = lst->fictional[cur_ind].next; }
+    else                      { for (size_t i = lst->size; i >  pos; --i) cur_ind = lst->fictional[cur_ind].prev; }
+
+$o  return cur_ind;
+}
+
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static size_t list_get_node_index(const list *const lst, const size_t pos)
+static size_t cache_list_get_node_pos(const cache_list *const lst, const size_t ind)
 {
 $i
-$   cache_lst_debug_verify(lst);
-    log_assert(pos <= $size);
+    LOG_ASSERT(lst != nullptr);
+    LOG_ASSERT(0 < ind && ind < lst->capacity);
+    LOG_ASSERT(cache_list_is_busy(lst, ind));
 
-    size_t cur_index = 0;
+    if (lst->is_linearized) { $o return ind - 1; }
 
-    if (2 * pos <= $size) { for (size_t i =     0; i <= pos; ++i) cur_index = $fictional[cur_index].next; }
-    else                  { for (size_t i = $size; i >  pos; --i) cur_index = $fictional[cur_index].prev; }
+    // идем от вершины в обе стороны сразу, пока одна из сторон не дойдет до фиктивной вершины
+    size_t ind_prev = ind;
+    size_t ind_next = ind;
 
-$o  return cur_index;
+    for (size_t steps = 0;; ++steps)
+    {
+        ind_prev = lst->fictional[ind_prev].prev;
+        if (ind_prev == 0) { $o return steps; }
+
+        ind_next = lst->fictional[ind_next].next;
+        if (ind_next == 0) { $o return lst->size - 1 - steps; }
+    }
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -514,19 +622,18 @@ $o  return cur_index;
 bool cache_list_insert(cache_list *const lst, const void *const data, const size_t pos)
 {
 $i
-$   cache_lst_verify(lst       , false);
-    log_verify (data != nullptr, false);
-    log_verify (pos  <=   $size, false);
+$   CACHE_LIST_VERIFY(lst       , false);
+    LOG_VERIFY(data != nullptr  , false);
+    LOG_VERIFY(pos  <= lst->size, false);
 
     size_t ind_prev = 0;
-    size_t ind_next = 0;
 
-    if (pos == 0) {   ind_prev = 0;                                 ind_next = $fictional->next;          }
-    else          { $ ind_prev = list_get_node_index(lst, pos - 1); ind_next = $fictional[ind_prev].next; }
+    if (pos == 0) {   ind_prev = 0;                                       }
+    else          { $ ind_prev = cache_list_get_node_index(lst, pos - 1); }
 
-$   bool ret = list_busy_node_new(lst, data, ind_prev, ind_next);
+$   bool ret = cache_list_busy_node_new(lst, data, ind_prev, lst->fictional[ind_prev].next);
 
-$   cache_lst_debug_verify(lst);
+$   CACHE_LIST_ASSERT(lst);
 $o  return ret;
 }
 
@@ -544,9 +651,69 @@ $o  return ret;
 bool cache_list_push_back(cache_list *const lst, const void *const data)
 {
 $i
-$  cache_lst_verify(lst, false);
+$   CACHE_LIST_VERIFY(lst, false);
+
+$   bool   ret = cache_list_insert(lst, data, lst->size);
+$o  return ret;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool cache_list_insert_n(cache_list *const lst, const void *const data, const size_t n, const size_t pos)
+{
+$i
+$   CACHE_LIST_VERIFY(lst       , false);
+    LOG_VERIFY(data != nullptr  , false);
+    LOG_VERIFY(pos  <= lst->size, false);
+
+    if (n == 0) { $o return true; }
+    if (n > CACHE_LIST_MAX_CAPACITY - lst->size)
+    {
+$       LOG_ERROR("cache_list capacity can't exceed CACHE_LIST_MAX_CAPACITY = %lu\n", CACHE_LIST_MAX_CAPACITY);
+$o      return false;
+    }
+$   if (!cache_list_grow(lst, lst->size + n)) { $o return false; }
+
+    size_t ind_prev = 0;
+    if (pos != 0) { $ ind_prev = cache_list_get_node_index(lst, pos - 1); }
+
+    const size_t ind_next = lst->fictional[ind_prev].next;
+    const char  *el_data  = (const char *) data;
+
+$   for (size_t i = 0; i < n; ++i)
+    {
+        // емкость уже достаточна: cache_list_busy_node_new() не будет перевыделять память
+        cache_list_busy_node_new(lst, el_data, ind_prev, ind_next);
+
+        ind_prev = lst->fictional[ind_next].prev;
+        el_data += lst->el_size;
+    }
+
+$   CACHE_LIST_ASSERT(lst);
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool cache_list_push_back_n(cache_list *const lst, const void *const data, const size_t n)
+{
+$i
+$   CACHE_LIST_VERIFY(lst, false);
+
+$   bool   ret = cache_list_insert_n(lst, data, n, lst->size);
+$o  return ret;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool cache_list_reserve(cache_list *const lst, const size_t el_count)
+{
+$i
+$   CACHE_LIST_VERIFY(lst, false);
 
-$   bool   ret = cache_list_insert(lst, data, $size);
+$   bool   ret = cache_list_grow(lst, el_count);
+
+$   CACHE_LIST_ASSERT(lst);
 $o  return ret;
 }
 
@@ -555,13 +722,13 @@ $o  return ret;
 bool cache_list_erase(cache_list *const lst, const size_t pos, void *const erased_data /* = nullptr */)
 {
 $i
-$   cache_lst_verify(lst  , false);
-    log_verify(pos < $size, false);
+$   CACHE_LIST_VERIFY(lst      , false);
+    LOG_VERIFY(pos < lst->size , false);
 
-$   size_t ind_cur = list_get_node_index(lst, pos);
-$   list_free_node_new(lst, ind_cur, erased_data);
+$   size_t ind_cur = cache_list_get_node_index(lst, pos);
+$   cache_list_free_node_new(lst, ind_cur, erased_data);
 
-$   cache_lst_debug_verify(lst);
+$   CACHE_LIST_ASSERT(lst);
 $o  return true;
 }
 
@@ -579,31 +746,98 @@ $o  return ret;
 bool cache_list_pop_back(cache_list *const lst, void *const erased_data /* = nullptr */)
 {
 $i
-$  cache_lst_verify(lst, false);
+$   CACHE_LIST_VERIFY(lst, false);
 
-$   bool   ret = cache_list_erase(lst, $size - 1, erased_data);
+$   bool   ret = cache_list_erase(lst, lst->size - 1, erased_data);
 $o  return ret;
 }
 
-//--------------------------------------------------------------------------------------------------------------------------------
-// list get
 //--------------------------------------------------------------------------------------------------------------------------------
 
-void *cache_list_get(const cache_list *const lst, const size_t pos)
+size_t cache_list_erase_if(cache_list *const lst, bool (*el_pred)(const void *el))
 {
 $i
-$   cache_lst_verify(lst  , nullptr);
-    log_verify(pos < $size, nullptr);
+$   CACHE_LIST_VERIFY(lst, 0);
+    LOG_VERIFY(el_pred != nullptr, 0);
 
-$   const size_t cur_ind = list_get_node_index(lst, pos);
-$   const void *geted_el = (char *) $data + cur_ind * $el_size;
+    cache_list_node *const nodes = lst->fictional;
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wcast-qual"
+    size_t ind_kept    = 0; // последняя оставшаяся вершина
+    size_t erased_head = 0; // цепочка удаленных вершин
+    size_t erased_tail = 0;
+    size_t erased_cnt  = 0;
 
-$o  return (void *) geted_el;
+    bool is_kept_after_erased = false;
 
-#pragma GCC diagnostic pop
+$   for (size_t ind = nodes->next; ind != 0;)
+    {
+        const size_t ind_next = nodes[ind].next;
+        void *const  el_data  = (char *) lst->data + ind * lst->el_size;
+
+        if (!el_pred(el_data))
+        {
+            nodes[ind_kept].next = (cache_list_index) ind;
+            nodes[ind].prev      = (cache_list_index) ind_kept;
+            ind_kept = ind;
+
+            is_kept_after_erased = is_kept_after_erased || erased_cnt != 0;
+        }
+        else
+        {
+            if (lst->el_dtor != nullptr) { $ lst->el_dtor(el_data); }
+            cache_list_set_busy(lst, ind, false);
+
+            if (erased_cnt == 0) erased_head = ind;
+            else
+            {
+                nodes[erased_tail].next = (cache_list_index) ind;
+                nodes[ind].prev         = (cache_list_index) erased_tail;
+            }
+            erased_tail = ind;
+            erased_cnt++;
+        }
+        ind = ind_next;
+    }
+    nodes[ind_kept].next = 0;
+    nodes->prev          = (cache_list_index) ind_kept;
+
+    if (erased_cnt == 0) { $o return 0; }
+
+    // цепочка удаленных вершин целиком встает в начало цикла свободных вершин
+    if (lst->el_free == lst->capacity)
+    {
+        nodes[erased_tail].next = (cache_list_index) erased_head;
+        nodes[erased_head].prev = (cache_list_index) erased_tail;
+    }
+    else
+    {
+        const size_t free_first = lst->el_free;
+        const size_t free_last  = nodes[free_first].prev;
+
+        nodes[free_last  ].next = (cache_list_index) erased_head;
+        nodes[erased_head].prev = (cache_list_index) free_last;
+        nodes[erased_tail].next = (cache_list_index) free_first;
+        nodes[free_first ].prev = (cache_list_index) erased_tail;
+    }
+    lst->el_free = erased_head;
+    lst->size   -= erased_cnt;
+
+    lst->is_linearized = lst->is_linearized && !is_kept_after_erased; // удален только хвост
+
+$   CACHE_LIST_ASSERT(lst);
+$o  return erased_cnt;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void *cache_list_get(const cache_list *const lst, const size_t pos)
+{
+$i
+$   CACHE_LIST_VERIFY(lst      , nullptr);
+    LOG_VERIFY(pos < lst->size , nullptr);
+
+$   const size_t cur_ind = cache_list_get_node_index(lst, pos);
+$o  return (char *) lst->data + cur_ind * lst->el_size;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -611,6 +845,10 @@ $o  return (void *) geted_el;
 void *cache_list_front(const cache_list *const lst)
 {
 $i
+$   CACHE_LIST_VERIFY(lst, nullptr);
+
+    if (lst->size == 0) { $o return nullptr; }
+
 $   void  *geted_el = cache_list_get(lst, 0);
 $o  return geted_el;
 }
@@ -620,9 +858,11 @@ $o  return geted_el;
 void *cache_list_back(const cache_list *const lst)
 {
 $i
-$  cache_lst_verify(lst, nullptr);
+$   CACHE_LIST_VERIFY(lst, nullptr);
 
-$   void  *geted_el = cache_list_get(lst, $size - 1);
+    if (lst->size == 0) { $o return nullptr; }
+
+$   void  *geted_el = cache_list_get(lst, lst->size - 1);
 $o  return geted_el;
 }
 
@@ -634,14 +874,14 @@ $o  return geted_el;
 void *cache_list_find(const cache_list *const lst, const void *const target, int (*el_cmp)(const void *el_1, const void *el_2))
 {
 $i
-$   cache_lst_verify(lst, nullptr);
-    log_verify(target !=  nullptr, nullptr);
-    log_verify(el_cmp !=  nullptr, nullptr);
+$   CACHE_LIST_VERIFY(lst, nullptr);
+    LOG_VERIFY(target != nullptr, nullptr);
+    LOG_VERIFY(el_cmp != nullptr, nullptr);
 
-$   for (size_t cur_ind = $fictional->next; cur_ind != 0; cur_ind = $fictional[cur_ind].next)
+$   for (size_t cur_ind = lst->fictional->next; cur_ind != 0; cur_ind = lst->fictional[cur_ind].next)
     {
-        const void *el_data = (const char *) $data + cur_ind * $el_size;
-        if (el_cmp (el_data, target) == 0) { $o return (void *) $data; }
+        const void *el_data = (const char *) lst->data + cur_ind * lst->el_size;
+        if (el_cmp(el_data, target) == 0) { $o return (void *) el_data; }
     }
 
 $o  return nullptr;
@@ -649,18 +889,54 @@ $o  return nullptr;
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-void *cache_list_find_through(const cache_list *const lst, const void *const target, int (*el_cmp)(const void *el_1, const void *el_2))
+void *cache_list_find_through(const cache_list *const lst, const void *const target, int (*el_cmp)(const void *el_1, const void *el_2),
+                                                                                     size_t *const pos /* = nullptr */)
 {
 $i
-$   cache_lst_verify(lst, nullptr);
-    log_verify(target !=  nullptr, nullptr);
-    log_verify(el_cmp !=  nullptr, nullptr);
+$   CACHE_LIST_VERIFY(lst, nullptr);
+    LOG_VERIFY(target != nullptr, nullptr);
+    LOG_VERIFY(el_cmp != nullptr, nullptr);
 
-    size_t cur_ind = 0;
-$   for (const char *el_data = (const char *) $data + $el_size; cur_ind < $size; el_data += $el_size)
+    const size_t words = cache_list_busy_words(lst->capacity);
+
+$   for (size_t word = 0; word < words; ++word)
     {
-        if (el_cmp(el_data, target) == 0) {$o return (void *) $data; }
-        ++cur_ind;
+        for (uint64_t busy = lst->busy[word]; busy != 0; busy &= busy - 1)
+        {
+            const size_t ind     = word * CACHE_LIST_BUSY_WORD_BITS + (size_t) __builtin_ctzll(busy);
+            const void  *el_data = (const char *) lst->data + ind * lst->el_size;
+
+            if (el_cmp(el_data, target) != 0) continue;
+
+$           if (pos != nullptr) *pos = cache_list_get_node_pos(lst, ind);
+$o          return (void *) el_data;
+        }
+    }
+
+$o  return nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void *cache_list_find_through_bytes(const cache_list *const lst, const void *const target, size_t *const pos /* = nullptr */)
+{
+$i
+$   CACHE_LIST_VERIFY(lst, nullptr);
+    LOG_VERIFY(target != nullptr, nullptr);
+
+    const size_t words = cache_list_busy_words(lst->capacity);
+
+$   for (size_t word = 0; word < words; ++word)
+    {
+        if (lst->busy[word] == 0) continue;
+
+        const uint64_t match = cache_list_equal_mask(lst, word, target);
+        if (match == 0) continue;
+
+        const size_t ind = word * CACHE_LIST_BUSY_WORD_BITS + (size_t) __builtin_ctzll(match);
+
+$       if (pos != nullptr) *pos = cache_list_get_node_pos(lst, ind);
+$o      return (char *) lst->data + ind * lst->el_size;
     }
 
 $o  return nullptr;
@@ -669,221 +945,561 @@ $o  return nullptr;
 #pragma GCC diagnostic pop
 
 //--------------------------------------------------------------------------------------------------------------------------------
-// dump
+
+/**
+*   Возвращает битовую маску занятых слотов блока word (слоты word * 64 ... word * 64 + 63), элементы в которых
+*   побайтово равны target.
+*/
+static uint64_t cache_list_equal_mask(const cache_list *const lst, const size_t word, const void *const target)
+{
+    LOG_ASSERT(lst    != nullptr);
+    LOG_ASSERT(target != nullptr);
+
+    const uint64_t busy  = lst->busy[word];
+    const size_t   first = word * CACHE_LIST_BUSY_WORD_BITS;
+    const char    *block = (const char *) lst->data + first * lst->el_size;
+
+#ifdef CACHE_LIST_X86
+    const bool is_simd_size  = lst->el_size == 1 || lst->el_size == 2 || lst->el_size == 4 || lst->el_size == 8;
+    const bool is_full_block = first + CACHE_LIST_BUSY_WORD_BITS <= lst->capacity;
+
+    if (is_simd_size && is_full_block) return cache_list_equal_mask_sse2(block, lst->el_size, target) & busy;
+#endif
+
+    uint64_t match = 0;
+    for (uint64_t rest = busy; rest != 0; rest &= rest - 1)
+    {
+        const size_t bit = (size_t) __builtin_ctzll(rest);
+        if (memcmp(block + bit * lst->el_size, target, lst->el_size) == 0) match |= 1UL << bit;
+    }
+
+    return match;
+}
+
 //--------------------------------------------------------------------------------------------------------------------------------
 
-void cache_list_dump(const void *const _lst)
+#ifdef CACHE_LIST_X86
+
+/**
+*   Сравнивает 64 подряд идущих элемента размера el_size (1, 2, 4 или 8 байт) с target, по 16 элементов за итерацию.
+*   Возвращает маску равных элементов без учета занятости слотов.
+*/
+static uint64_t cache_list_equal_mask_sse2(const char *const block, const size_t el_size, const void *const target)
+{
+    const __m128i *src   = (const __m128i *) block;
+    uint64_t       match = 0;
+
+    switch (el_size)
+    {
+        case 1:
+        {
+            uint8_t val = 0; memcpy(&val, target, 1);
+            const __m128i pattern = _mm_set1_epi8((char) val);
+
+            for (size_t i = 0; i < 4; ++i, src += 1)
+            {
+                const __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128(src), pattern);
+                match |= (uint64_t) (unsigned) _mm_movemask_epi8(eq) << (16 * i);
+            }
+            break;
+        }
+        case 2:
+        {
+            uint16_t val = 0; memcpy(&val, target, 2);
+            const __m128i pattern = _mm_set1_epi16((short) val);
+
+            for (size_t i = 0; i < 4; ++i, src += 2)
+            {
+                const __m128i eq_0 = _mm_cmpeq_epi16(_mm_loadu_si128(src + 0), pattern);
+                const __m128i eq_1 = _mm_cmpeq_epi16(_mm_loadu_si128(src + 1), pattern);
+                match |= (uint64_t) (unsigned) _mm_movemask_epi8(_mm_packs_epi16(eq_0, eq_1)) << (16 * i);
+            }
+            break;
+        }
+        case 4:
+        {
+            uint32_t val = 0; memcpy(&val, target, 4);
+            const __m128i pattern = _mm_set1_epi32((int) val);
+
+            for (size_t i = 0; i < 4; ++i, src += 4)
+            {
+                const __m128i eq_01 = _mm_packs_epi32(_mm_cmpeq_epi32(_mm_loadu_si128(src + 0), pattern),
+                                                      _mm_cmpeq_epi32(_mm_loadu_si128(src + 1), pattern));
+                const __m128i eq_23 = _mm_packs_epi32(_mm_cmpeq_epi32(_mm_loadu_si128(src + 2), pattern),
+                                                      _mm_cmpeq_epi32(_mm_loadu_si128(src + 3), pattern));
+                match |= (uint64_t) (unsigned) _mm_movemask_epi8(_mm_packs_epi16(eq_01, eq_23)) << (16 * i);
+            }
+            break;
+        }
+        case 8:
+        {
+            uint64_t val = 0; memcpy(&val, target, 8);
+            const __m128i pattern = _mm_set1_epi64x((long long) val);
+
+            for (size_t i = 0; i < 32; ++i, src += 1)
+            {
+                const __m128i eq_32 = _mm_cmpeq_epi32(_mm_loadu_si128(src), pattern);
+                const __m128i eq_64 = _mm_and_si128(eq_32, _mm_shuffle_epi32(eq_32, _MM_SHUFFLE(2, 3, 0, 1)));
+                match |= (uint64_t) (unsigned) _mm_movemask_pd(_mm_castsi128_pd(eq_64)) << (2 * i);
+            }
+            break;
+        }
+        default: LOG_ASSERT(false && "unexpected el_size");
+    }
+
+    return match;
+}
+
+#endif // CACHE_LIST_X86
+
+//================================================================================================================================
+// COMPACT
+//================================================================================================================================
+
+bool cache_list_compact(cache_list *const lst)
 {
 $i
-    const list *const lst = (const list *) _lst;
-$   cache_lst_verify (lst, (void) 0);
+$   CACHE_LIST_VERIFY(lst, false);
 
-    #if !defined(NDEBUG) && !defined(CACHE_LIST_NDEBUG)
-$   list_static_dump(lst, true);
-    #else
-$   list_static_dump(lst, false);
-    #endif
-$o
+    if (lst->is_linearized) { $o return true; }
+
+    size_t ind_cur = lst->fictional->next;
+$   for (size_t ind_placed = 1; ind_placed <= lst->size; ++ind_placed)
+    {
+        if (ind_cur != ind_placed) cache_list_node_swap(lst, ind_placed, ind_cur);
+        ind_cur = lst->fictional[ind_placed].next;
+    }
+
+    if (lst->size + 1 == lst->capacity) { lst->el_free = lst->capacity; }
+    else
+    {
+        lst->el_free = lst->size + 1;
+$       cache_list_free_cycle_ctor(lst);
+    }
+    lst->is_linearized = true;
+
+$   CACHE_LIST_ASSERT(lst);
+$o  return true;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static void list_static_dump(const list *const lst, const bool is_full)
+/**
+*   Меняет местами вершины ind_placed и ind_cur. Слоты [1, ind_placed) уже заняты первыми элементами кэш-листа по порядку,
+*   вершина ind_cur (> ind_placed) - следующий по порядку элемент. Вершина ind_placed может быть как свободной, так и занятой
+*   (тогда она идет позже в кэш-листе, возможно, сразу после ind_cur). Связи свободных вершин не поддерживаются:
+*   cache_list_compact() строит цикл свободных вершин заново.
+*/
+static void cache_list_node_swap(cache_list *const lst, const size_t ind_placed, const size_t ind_cur)
+{
+    LOG_ASSERT(lst != nullptr);
+    LOG_ASSERT(0 < ind_placed && ind_placed < ind_cur && ind_cur < lst->capacity);
+    LOG_ASSERT(cache_list_is_busy(lst, ind_cur));
+
+    cache_list_node *const nodes = lst->fictional;
+
+    cache_list_node node_placed = nodes[ind_placed];
+    cache_list_node node_cur    = nodes[ind_cur];
+
+    const cache_list_index link_placed    = (cache_list_index) ind_placed;
+    const cache_list_index link_cur       = (cache_list_index) ind_cur;
+    const bool             is_placed_busy = cache_list_is_busy(lst, ind_placed);
+
+    LOG_ASSERT(node_cur.prev == ind_placed - 1);
+
+    nodes[node_cur.prev].next = link_placed;
+
+    if (is_placed_busy && node_placed.prev == link_cur) // ind_cur -> ind_placed
+    {
+        nodes[node_placed.next].prev = link_cur;
+
+        node_cur   .next = link_cur;
+        node_placed.prev = link_placed;
+    }
+    else
+    {
+        nodes[node_cur.next].prev = link_placed;
+
+        if (is_placed_busy)
+        {
+            nodes[node_placed.prev].next = link_cur;
+            nodes[node_placed.next].prev = link_cur;
+        }
+    }
+
+    nodes[ind_placed] = node_cur;
+    nodes[ind_cur]    = node_placed;
+
+    cache_list_set_busy(lst, ind_placed, true);
+    cache_list_set_busy(lst, ind_cur   , is_placed_busy);
+
+    char *data_placed = (char *) lst->data + ind_placed * lst->el_size;
+    char *data_cur    = (char *) lst->data + ind_cur    * lst->el_size;
+
+    if (is_placed_busy) my_swap(data_placed, data_cur, lst->el_size);
+    else                memcpy (data_placed, data_cur, lst->el_size);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool cache_list_sort(cache_list *const lst, int (*el_cmp)(const void *el_1, const void *el_2))
+{
+$i
+$   CACHE_LIST_VERIFY(lst, false);
+    LOG_VERIFY(el_cmp != nullptr, false);
+
+    if (lst->size < 2) { $o return true; }
+
+$   if (!cache_list_compact(lst)) { $o return false; }
+$   if (!my_sort((char *) lst->data + lst->el_size, lst->size, lst->el_size, el_cmp)) { $o return false; }
+
+$   CACHE_LIST_ASSERT(lst);
+$o  return true;
+}
+
+//================================================================================================================================
+// CURSOR
+//================================================================================================================================
+
+bool cache_list_cursor_ctor(cache_list_cursor *const cur, cache_list *const lst, const size_t pos /* = 0 */)
 {
 $i
-$   if (!list_header_dump(lst)) { $o return; }
+    LOG_VERIFY(cur != nullptr, false);
+$   CACHE_LIST_VERIFY(lst, false);
+    LOG_VERIFY(pos <= lst->size, false);
+
+    cur->lst = lst;
+$   cur->ind = cache_list_get_node_index(lst, pos);
+    cur->pos = pos;
+
+$o  return true;
+}
 
-$   bool are_invalid_public_fields =           list_public_fields_dump(lst);
-$   bool are_invalid_static_fields = is_full ? list_static_fields_dump(lst) : false;
+//--------------------------------------------------------------------------------------------------------------------------------
 
-    bool are_invalid_fields = are_invalid_public_fields | are_invalid_static_fields;
+void *cache_list_cursor_get(const cache_list_cursor *const cur)
+{
+$i
+    LOG_VERIFY(cur      != nullptr, nullptr);
+    LOG_VERIFY(cur->lst != nullptr, nullptr);
+    LOG_ASSERT(cur->pos <= cur->lst->size);
 
-$   list_data_dump(lst, is_full, are_invalid_fields);
+    if (cur->ind == 0) { $o return nullptr; }
+$o  return (char *) cur->lst->data + cur->ind * cur->lst->el_size;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool cache_list_cursor_advance(cache_list_cursor *const cur, const long step /* = 1 */)
+{
+$i
+    LOG_VERIFY(cur      != nullptr, false);
+    LOG_VERIFY(cur->lst != nullptr, false);
+
+    const cache_list *const lst = cur->lst;
+    LOG_ASSERT(cur->pos <= lst->size);
+
+    // 0 - (size_t) step, а не -step: -LONG_MIN не помещается в long
+    if (step >= 0 &&     (size_t) step > lst->size - cur->pos) { $o return false; }
+    if (step <  0 && 0 - (size_t) step > cur->pos)             { $o return false; }
+
+    size_t ind = cur->ind;
+
+    if (step >= 0) { for (long i = 0; i < step; ++i) ind = lst->fictional[ind].next; }
+    else           { for (long i = 0; i > step; --i) ind = lst->fictional[ind].prev; }
+
+    cur->ind = ind;
+    cur->pos = (size_t) ((long) cur->pos + step);
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool cache_list_cursor_seek(cache_list_cursor *const cur, const size_t pos)
+{
+$i
+    LOG_VERIFY(cur      != nullptr, false);
+    LOG_VERIFY(cur->lst != nullptr, false);
+
+    const cache_list *const lst = cur->lst;
+    LOG_VERIFY(pos <= lst->size, false);
+
+    const size_t from_cur  = (pos > cur->pos) ? pos - cur->pos : cur->pos - pos;
+    const size_t from_ends = (2 * pos <= lst->size) ? pos + 1 : lst->size - pos;
+
+    if (!lst->is_linearized && from_cur <= from_ends)
+    {
+$       bool   ret = cache_list_cursor_advance(cur, (long) pos - (long) cur->pos);
+$o      return ret;
+    }
+
+$   cur->ind = cache_list_get_node_index(lst, pos);
+    cur->pos = pos;
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool cache_list_cursor_insert_before(cache_list_cursor *const cur, const void *const data)
+{
+$i
+    LOG_VERIFY(cur  != nullptr, false);
+    LOG_VERIFY(data != nullptr, false);
+
+    cache_list *const lst = cur->lst;
+$   CACHE_LIST_VERIFY(lst, false);
+    LOG_ASSERT(cur->pos <= lst->size);
+
+$   if (!cache_list_busy_node_new(lst, data, lst->fictional[cur->ind].prev, cur->ind)) { $o return false; }
+    cur->pos++;
+
+$   CACHE_LIST_ASSERT(lst);
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool cache_list_cursor_erase(cache_list_cursor *const cur, void *const erased_data /* = nullptr */)
+{
+$i
+    LOG_VERIFY(cur != nullptr, false);
+
+    cache_list *const lst = cur->lst;
+$   CACHE_LIST_VERIFY(lst, false);
+    LOG_VERIFY(cur->pos < lst->size, false);
+
+    const size_t ind_next = lst->fictional[cur->ind].next;
+
+$   cache_list_free_node_new(lst, cur->ind, erased_data);
+    cur->ind = ind_next;
+
+$   CACHE_LIST_ASSERT(lst);
+$o  return true;
+}
+
+//================================================================================================================================
+// DUMP
+//================================================================================================================================
+
+void cache_list_dump(const void *const _lst)
+{
+$i
+    const cache_list *const lst = (const cache_list *) _lst;
+$   CACHE_LIST_VERIFY(lst, (void) 0);
+
+#ifndef CACHE_LIST_NDEBUG
+$   cache_list_static_dump(lst, true);
+#else
+$   cache_list_static_dump(lst, false);
+#endif
+$o
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void cache_list_static_dump(const cache_list *const lst, const bool is_full)
+{
+$i
+$   if (!cache_list_header_dump(lst)) { $o return; }
+
+    bool are_invalid_public_fields =           cache_list_public_fields_dump(lst);
+    bool are_invalid_static_fields = is_full ? cache_list_static_fields_dump(lst) : false;
+    bool are_invalid_fields        = are_invalid_public_fields || are_invalid_static_fields;
+
+$   cache_list_data_dump(lst, is_full, are_invalid_fields);
 
     LOG_TAB--;
-$   log_tab_service_message("}", "\n");
+$   LOG_TAB_SERVICE_MESSAGE("}", "\n");
 $o
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static bool list_header_dump(const list *const lst)
+static bool cache_list_header_dump(const cache_list *const lst)
 {
 $i
-$   log_tab_service_message("cache_list (address: %p)\n"
-                            "{", "\n",           lst);
+$   LOG_TAB_SERVICE_MESSAGE("cache_list (address: %p)\n"
+                            "{", "\n", lst);
 
-$   if (lst == nullptr) { log_tab_service_message("}", "\n"); $o return false; }
-    LOG_TAB++;
+$   if (lst == nullptr)
+    {
+        LOG_TAB_SERVICE_MESSAGE("}", "\n");
+$o      return false;
+    }
 
+    LOG_TAB++;
 $o  return true;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static bool list_public_fields_dump(const list *const lst)
+static bool cache_list_public_fields_dump(const cache_list *const lst)
 {
 $i
-    log_assert(lst != nullptr);
+    LOG_ASSERT(lst != nullptr);
 
     bool is_any_invalid = false;
 
-    if      ($data     == LST_POISON.data)     { $ poison_field_dump ("data    ");               is_any_invalid = true; }
-    else if ($data     == nullptr)             { $ error_field_dump  ("data    ", "%p" , $data); is_any_invalid = true; }
-    else                                       { $ usual_field_dump  ("data    ", "%p" , $data); }
+    if      (lst->data     == CACHE_LST_POISON.data)     { $ POISON_FIELD_DUMP ("data    ");                      is_any_invalid = true; }
+    else if (lst->data     == nullptr)                   { $ ERROR_FIELD_DUMP  ("data    ", "%p" , nullptr);      is_any_invalid = true; }
+    else                                                 { $ USUAL_FIELD_DUMP  ("data    ", "%p" , lst->data); }
 
-    if      ($size     == LST_POISON.size)     { $ poison_field_dump ("size    ");               is_any_invalid = true; }
-    else if ($size     >= $capacity)           { $ error_field_dump  ("size    ", "%lu", $size); is_any_invalid = true; }
-    else                                       { $ usual_field_dump  ("size    ", "%lu", $size); }
+    if      (lst->size     == CACHE_LST_POISON.size)     { $ POISON_FIELD_DUMP ("size    ");                      is_any_invalid = true; }
+    else if (lst->size     >= lst->capacity)             { $ ERROR_FIELD_DUMP  ("size    ", "%lu", lst->size);    is_any_invalid = true; }
+    else                                                 { $ USUAL_FIELD_DUMP  ("size    ", "%lu", lst->size); }
 
-    if      ($capacity == LST_POISON.capacity) { $ poison_field_dump ("capacity");                   is_any_invalid = true; }
-    else if ($capacity <= $size)               { $ error_field_dump  ("capacity", "%lu", $capacity); is_any_invalid = true; }
-    else                                       { $ usual_field_dump  ("capacity", "%lu", $capacity); }
+    if      (lst->capacity == CACHE_LST_POISON.capacity) { $ POISON_FIELD_DUMP ("capacity");                      is_any_invalid = true; }
+    else if (lst->capacity <= lst->size)                 { $ ERROR_FIELD_DUMP  ("capacity", "%lu", lst->capacity);is_any_invalid = true; }
+    else                                                 { $ USUAL_FIELD_DUMP  ("capacity", "%lu", lst->capacity); }
 
-    if      ($el_size  == LST_POISON.el_size)  { $ poison_field_dump("el_size  "); is_any_invalid = true; }
-    else if ($el_size  == 0UL)                 { $ error_field_dump ("el_size  ", "%lu", $el_size); }
-    else                                       { $ usual_field_dump ("el_size  ", "%lu", $el_size); }
+    if      (lst->el_size  == CACHE_LST_POISON.el_size)  { $ POISON_FIELD_DUMP ("el_size ");                      is_any_invalid = true; }
+    else if (lst->el_size  == 0UL)                       { $ ERROR_FIELD_DUMP  ("el_size ", "%lu", 0UL);          is_any_invalid = true; }
+    else                                                 { $ USUAL_FIELD_DUMP  ("el_size ", "%lu", lst->el_size); }
 
-    if      ($el_dtor  == LST_POISON.el_dtor)  { $ poison_field_dump ("el_dtor "); is_any_invalid = true; }
-    else if ($el_dtor  == nullptr)             { $ warning_field_dump("el_dtor ", "%p",  nullptr);        }
-    else                                       { $ usual_field_dump  ("el_dtor ", "%p", $el_dtor);        }
+    if      (lst->el_dtor  == CACHE_LST_POISON.el_dtor)  { $ POISON_FIELD_DUMP ("el_dtor ");                      is_any_invalid = true; }
+    else if (lst->el_dtor  == nullptr)                   { $ WARNING_FIELD_DUMP("el_dtor ", "%p" , nullptr); }
+    else                                                 { $ USUAL_FIELD_DUMP  ("el_dtor ", "%p" , lst->el_dtor); }
 
-    if      ($el_dump  == LST_POISON.el_dump)  { $ poison_field_dump ("el_dump "); is_any_invalid = true; }
-    else if ($el_dump  == nullptr)             { $ warning_field_dump("el_dump ", "%p",   nullptr);       }
-    else                                       { $ usual_field_dump  ("el_dump ", "%p",  $el_dump);       }
+    if      (lst->el_dump  == CACHE_LST_POISON.el_dump)  { $ POISON_FIELD_DUMP ("el_dump ");                      is_any_invalid = true; }
+    else if (lst->el_dump  == nullptr)                   { $ WARNING_FIELD_DUMP("el_dump ", "%p" , nullptr); }
+    else                                                 { $ USUAL_FIELD_DUMP  ("el_dump ", "%p" , lst->el_dump); }
 
-$   log_message("\n");
+$   USUAL_FIELD_DUMP("is_linearized", "%d", lst->is_linearized);
 
+$   LOG_MESSAGE("\n");
 $o  return is_any_invalid;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static bool list_static_fields_dump(const list *const lst)
+static bool cache_list_static_fields_dump(const cache_list *const lst)
 {
 $i
-    log_assert(lst != nullptr);
+    LOG_ASSERT(lst != nullptr);
 
     bool is_any_invalid = false;
 
-    if      ($fictional == LST_POISON.fictional) { $ poison_field_dump("fictional");                   is_any_invalid = true; }
-    else if ($fictional == nullptr)              { $ error_field_dump ("fictional", "%p",    nullptr); is_any_invalid = true; }
-    else                                         { $ usual_field_dump ("fictional", "%p", $fictional); }
+    if      (lst->fictional == CACHE_LST_POISON.fictional) { $ POISON_FIELD_DUMP("fictional");                     is_any_invalid = true; }
+    else if (lst->fictional == nullptr)                    { $ ERROR_FIELD_DUMP ("fictional", "%p" , nullptr);     is_any_invalid = true; }
+    else                                                   { $ USUAL_FIELD_DUMP ("fictional", "%p" , lst->fictional); }
 
-    if      ($el_free   == LST_POISON.el_free)   { $ poison_field_dump("el_free  ");                  is_any_invalid = true; }
-    else if ($el_free   >  $capacity)            { $ error_field_dump ("el_free  ", "%lu", $el_free); is_any_invalid = true; }
-    else                                         { $ usual_field_dump ("el_free  ", "%lu", $el_free); }
+    if      (lst->busy      == CACHE_LST_POISON.busy)      { $ POISON_FIELD_DUMP("busy     ");                     is_any_invalid = true; }
+    else if (lst->busy      == nullptr)                    { $ ERROR_FIELD_DUMP ("busy     ", "%p" , nullptr);     is_any_invalid = true; }
+    else                                                   { $ USUAL_FIELD_DUMP ("busy     ", "%p" , lst->busy); }
 
-$   log_message("\n");
+    if      (lst->el_free   == CACHE_LST_POISON.el_free)   { $ POISON_FIELD_DUMP("el_free  ");                     is_any_invalid = true; }
+    else if (lst->el_free   >  lst->capacity)              { $ ERROR_FIELD_DUMP ("el_free  ", "%lu", lst->el_free);is_any_invalid = true; }
+    else                                                   { $ USUAL_FIELD_DUMP ("el_free  ", "%lu", lst->el_free); }
 
+$   LOG_MESSAGE("\n");
 $o  return is_any_invalid;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static void list_data_dump(const list *const lst, const bool is_full,
-                                                  const bool is_any_invalid)
+static void cache_list_data_dump(const cache_list *const lst, const bool is_full,
+                                                              const bool is_any_invalid)
 {
 $i
-    log_assert(lst != nullptr);
+    LOG_ASSERT(lst != nullptr);
 
-$   log_tab_service_message("data\n"
-                            "{", "\n");
+$   LOG_TAB_SERVICE_MESSAGE("data\n" "{", "\n");
     LOG_TAB++;
 
     if (is_any_invalid)
     {
-$       log_tab_error_message("can't dump it because some of fields are invalid", "\n");
+$       LOG_TAB_ERROR_MESSAGE("can't dump it because some of fields are invalid", "\n");
     }
-    else if (is_full) { $ list_data_debug_dump (lst); }
-    else              { $ list_data_pretty_dump(lst); }
+    else if (is_full) { $ cache_list_data_debug_dump (lst); }
+    else              { $ cache_list_data_pretty_dump(lst); }
 
     LOG_TAB--;
-$   log_tab_service_message("}", "\n");
+$   LOG_TAB_SERVICE_MESSAGE("}", "\n");
 $o
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static void list_data_debug_dump(const list *const lst)
+static void cache_list_data_debug_dump(const cache_list *const lst)
 {
 $i
-    log_assert(lst        != nullptr);
-
-    log_assert($fictional != LST_POISON.fictional);
-    log_assert($data      != LST_POISON.data     );
-
-    log_assert($fictional != nullptr);
-    log_assert($data      != nullptr);
-
-    size_t cur_ind = 0;
-    for (const char *el_data = (const char *) $data; cur_ind < $capacity; el_data += $el_size)
+    LOG_ASSERT(lst            != nullptr);
+    LOG_ASSERT(lst->fictional != CACHE_LST_POISON.fictional);
+    LOG_ASSERT(lst->data      != CACHE_LST_POISON.data);
+    LOG_ASSERT(lst->busy      != CACHE_LST_POISON.busy);
+    LOG_ASSERT(lst->fictional != nullptr);
+    LOG_ASSERT(lst->data      != nullptr);
+    LOG_ASSERT(lst->busy      != nullptr);
+
+    const char *el_data = (const char *) lst->data;
+    for (size_t cur_ind = 0; cur_ind < lst->capacity; ++cur_ind)
     {
-$       log_tab_service_message("#%lu\n{", "\n", cur_ind);
+$       LOG_TAB_SERVICE_MESSAGE("#%lu:\n" "{", "\n", cur_ind);
         LOG_TAB++;
-
-$       list_node_debug_dump(lst, $fictional + cur_ind, el_data);
-        cur_ind++;
-
+$       cache_list_node_debug_dump(lst, cur_ind, el_data);
         LOG_TAB--;
-$       log_tab_service_message("}", "\n");
+$       LOG_TAB_SERVICE_MESSAGE("}", "\n");
+
+        el_data += lst->el_size;
     }
 $o
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static void list_node_debug_dump(const list *const lst, const list_node *const lst_node, const void *const el_data)
+static void cache_list_node_debug_dump(const cache_list *const lst, const size_t ind, const void *const el_data)
 {
 $i
-    log_assert(lst_node != nullptr);
-    log_assert($data    != nullptr);
-    log_assert(el_data  != nullptr);
+    LOG_ASSERT(lst     != nullptr);
+    LOG_ASSERT(el_data != nullptr);
 
-    if ($fictional == lst_node) { $ log_tab_service_message("FICTIONAL", "\n"); }
-    else if ($is_busy)          { $ log_tab_service_message("BUSY"     , "\n"); }
-    else                        { $ log_tab_service_message("FREE"     , "\n"); }
+    const size_t prev    = lst->fictional[ind].prev;
+    const size_t next    = lst->fictional[ind].next;
+    const bool   is_busy = cache_list_is_busy(lst, ind);
 
-    if ($prev >= $capacity) { $ error_field_dump("prev", "%lu", $prev); }
-    else                    { $ usual_field_dump("prev", "%lu", $prev); }
+    if      (ind == 0) { $ LOG_TAB_SERVICE_MESSAGE("FICTIONAL", "\n"); }
+    else if (is_busy)  { $ LOG_TAB_SERVICE_MESSAGE("BUSY"     , "\n"); }
+    else               { $ LOG_TAB_SERVICE_MESSAGE("FREE"     , "\n"); }
 
-    if ($next >= $capacity) { $ error_field_dump("next", "%lu", $next); }
-    else                    { $ usual_field_dump("next", "%lu", $next); }
+    if (prev >= lst->capacity) { $ ERROR_FIELD_DUMP("prev", "%lu", prev); }
+    else                       { $ USUAL_FIELD_DUMP("prev", "%lu", prev); }
 
-    if (!$is_busy) { $o return; }
-$   log_message("\n");
+    if (next >= lst->capacity) { $ ERROR_FIELD_DUMP("next", "%lu", next); }
+    else                       { $ USUAL_FIELD_DUMP("next", "%lu", next); }
 
-    if ($el_dump == nullptr) { $ log_tab_warning_message("don't know how to dump the elem", "\n"); }
-    else                     { $ $el_dump(el_data); }
+    if (!is_busy) { $o return; }
+$   LOG_MESSAGE("\n");
+
+    if (lst->el_dump == nullptr) { $ LOG_TAB_WARNING_MESSAGE("don't know how to dump the elem", "\n"); }
+    else                         { $ lst->el_dump(el_data); }
 $o
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static void list_data_pretty_dump(const list *const lst)
+static void cache_list_data_pretty_dump(const cache_list *const lst)
 {
 $i
-    log_assert(lst        != nullptr);
-
-    log_assert($fictional != LST_POISON.fictional);
-    log_assert($data      != LST_POISON.data     );
+    LOG_ASSERT(lst            != nullptr);
+    LOG_ASSERT(lst->fictional != CACHE_LST_POISON.fictional);
+    LOG_ASSERT(lst->data      != CACHE_LST_POISON.data);
+    LOG_ASSERT(lst->fictional != nullptr);
+    LOG_ASSERT(lst->data      != nullptr);
 
-    log_assert($fictional != nullptr);
-    log_assert($data      != nullptr);
-
-$   if ($el_dump == nullptr) { log_tab_warning_message("don't know how to dump the content", "\n"); $o return; }
+$   if (lst->el_dump == nullptr) { LOG_TAB_WARNING_MESSAGE("don't know how to dump the content", "\n"); $o return; }
 
     size_t cur_pos = 0;
-    for (size_t cur_ind = $fictional->next; cur_ind != 0; cur_ind = $fictional[cur_ind].next)
+    for (size_t cur_ind = lst->fictional->next; cur_ind != 0; cur_ind = lst->fictional[cur_ind].next)
     {
-$       log_tab_service_message("#%lu\n{", "\n", cur_pos);
+$       LOG_TAB_SERVICE_MESSAGE("#%lu:\n" "{", "\n", cur_pos);
         LOG_TAB++;
-
-$       $el_dump((const char *) $data + cur_ind * $el_size);
-        cur_pos++;
-
+$       lst->el_dump((const char *) lst->data + cur_ind * lst->el_size);
         LOG_TAB--;
-$       log_tab_service_message("}", "\n");
+$       LOG_TAB_SERVICE_MESSAGE("}", "\n");
+
+        ++cur_pos;
     }
 $o
 }
@@ -21,8 +21,38 @@ extern const double DELTA; ///< погрешность сравнения вещ
 */
 int dblcmp(const double a, const double b, const double error_rate = DELTA);
 
+/**
+*   @brief Поэлементно сравнивает два массива вещественных чисел: out[i] = dblcmp(a[i], b[i], error_rate).
+*   Конечность чисел проверяется один раз для всех массивов, сравнение выполняется SIMD-блоками
+*   (AVX2 или SSE2, выбирается по возможностям процессора при загрузке программы).
+*
+*   @param a          [in]  - первый массив
+*   @param b          [in]  - второй массив
+*   @param out        [out] - массив результатов сравнения (n элементов)
+*   @param n          [in]  - количество элементов
+*   @param error_rate [in]  - погрешность сравнения
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool dblcmp_n(const double *a, const double *b, int *out, const size_t n, const double error_rate = DELTA);
+
+/**
+*   @brief Ищет первую пару элементов двух массивов, не равных с учетом погрешности error_rate.
+*   Конечность чисел проверяется один раз для всех массивов, поиск выполняется SIMD-блоками.
+*
+*   @param a          [in] - первый массив
+*   @param b          [in] - второй массив
+*   @param n          [in] - количество элементов
+*   @param error_rate [in] - погрешность сравнения
+*
+*   @return индекс первой неравной пары; n, если все пары равны; SIZE_MAX в случае ошибки.
+*/
+size_t dblcmp_mismatch(const double *a, const double *b, const size_t n, const double error_rate = DELTA);
+
 /**
 *   @brief Обменивает значения двух переменных.
+*   Для размеров 1, 2, 4, 8 и 16 байт обмен выполняется одной парой загрузок/записей, для средних размеров - машинными словами,
+*   для больших (от SWAP_BLOCK_MIN_SIZE байт) - SIMD-блоками (AVX2 или SSE2, выбирается по возможностям процессора при загрузке программы).
 *
 *   @param a         [in, out] - указатель на первую переменную
 *   @param b         [in, out] - указатель на вторую переменную
@@ -30,4 +60,40 @@ int dblcmp(const double a, const double b, const double error_rate = DELTA);
 */
 void my_swap(void *a, void *b, size_t elem_size);
 
+/**
+*   @brief Сортирует массив элементов произвольного размера (introsort).
+*   Короткие участки досортировываются вставками, при слишком глубокой рекурсии сортировка переходит к пирамидальной,
+*   поэтому время работы O(n log n) в худшем случае. Для элементов размера 4, 8 и 16 байт используются специализированные копирование и обмен.
+*   Сортировка неустойчивая.
+*
+*   @param base    [in, out] - указатель на начало массива
+*   @param n       [in]      - количество элементов
+*   @param el_size [in]      - размер элемента (в байтах)
+*   @param el_cmp  [in]      - указатель на функцию сравнения элементов (аналогично qsort)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool my_sort(void *base, const size_t n, const size_t el_size, int (*el_cmp)(const void *el_1, const void *el_2));
+
+/**
+*   @brief Сортирует массив в несколько потоков.
+*   Массив делится на thread_count участков, которые сортируются параллельно так же, как в my_sort(), после чего
+*   участки попарно сливаются на месте. Каждое слияние тоже делится между потоками по точкам разреза, найденным двоичным поиском.
+*   Дополнительная память - буфер на 256 КиБ (но не меньше одного элемента) на поток и не зависит от n.
+*   Пары, ни один участок которых не помещается в буфер, перед слиянием делятся поворотами на меньшие.
+*   Короткие массивы (меньше 2 * SORT_PARALLEL_MIN_CHUNK элементов) сортируются в текущем потоке.
+*   Если не удалось выделить память под слияние, массив тоже сортируется в текущем потоке.
+*   Функция сравнения вызывается из нескольких потоков одновременно.
+*
+*   @param base         [in, out] - указатель на начало массива
+*   @param n            [in]      - количество элементов
+*   @param el_size      [in]      - размер элемента (в байтах)
+*   @param el_cmp       [in]      - указатель на функцию сравнения элементов (аналогично qsort)
+*   @param thread_count [in]      - количество потоков (0 - по количеству доступных процессоров)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool my_parallel_sort(void *base, const size_t n, const size_t el_size, int (*el_cmp)(const void *el_1, const void *el_2),
+                      const size_t thread_count = 0);
+
 #endif // ALGORITHM_H
@@ -0,0 +1,221 @@
+/** @file */
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <stdlib.h>
+
+//================================================================================================================================
+
+/**
+*   @brief Интерфейс аллокатора.
+*
+*   Контейнеры хранят указатель на аллокатор и выделяют через него всю свою память. nullptr вместо аллокатора означает
+*   LOG_CALLOC / LOG_RECALLOC / LOG_FREE, как и раньше. Выделенная память всегда заполнена нулями, а при освобождении
+*   и изменении размера контейнер передает размер блока, поэтому аллокаторам не нужны заголовки перед блоками.
+*/
+struct allocator
+{
+    void *(*alloc_fn)   (allocator *const alc, const size_t size);                                              ///< выделяет size байт, заполненных нулями
+    void *(*realloc_fn) (allocator *const alc, void *const ptr, const size_t old_size, const size_t new_size); ///< меняет размер блока, новые байты - нули
+    void  (*free_fn)    (allocator *const alc, void *const ptr, const size_t size);                            ///< освобождает блок размера size
+};
+
+/**
+*   @brief Блок памяти арены.
+*/
+struct arena_block
+{
+    arena_block *next;  ///< следующий блок
+    size_t       size;  ///< размер блока (без заголовка)
+};
+
+/**
+*   @brief Арена: аллокатор, выделяющий память сдвигом указателя внутри больших блоков.
+*
+*   Освобождение отдельного блока возвращает память, только если это последний выделенный блок, а изменение размера
+*   последнего блока происходит на месте. arena_reset() за O(1) освобождает всю память арены, оставляя блоки для
+*   повторного использования, arena_dtor() возвращает блоки системе.
+*/
+struct arena
+{
+    allocator base;         ///< интерфейс аллокатора
+
+    arena_block *first;     ///< первый блок
+    arena_block *cur;       ///< блок, из которого сейчас выделяется память
+
+    char *pos;              ///< начало свободной части текущего блока
+    char *end;              ///< конец текущего блока
+
+    size_t block_size;      ///< размер следующего выделяемого блока
+};
+
+static const size_t POOL_CLASS_COUNT = 9; ///< количество классов размеров пула: 16, 32, ..., 4096 байт
+
+/**
+*   @brief Пул: аллокатор со списками свободных блоков по классам размеров (степени двойки от 16 до 4096 байт).
+*
+*   Память под блоки берется из внутренней арены, освобожденные блоки переиспользуются блоками того же класса.
+*   Блоки больше 4096 байт выделяются через LOG_CALLOC и должны быть освобождены до pool_dtor().
+*/
+struct pool
+{
+    allocator base;                         ///< интерфейс аллокатора
+
+    void *free_lists[POOL_CLASS_COUNT];     ///< списки свободных блоков по классам размеров
+    arena slabs;                            ///< арена, из которой нарезаются блоки
+};
+
+/**
+*   @brief Slab: аллокатор блоков одного размера (например, вершин листа) со списком свободных блоков.
+*
+*   Блоки нарезаются подряд из больших кусков внутренней арены, поэтому выделенные друг за другом блоки лежат рядом в памяти.
+*   Освобожденные блоки переиспользуются. Один slab можно разделить между несколькими контейнерами с одинаковым размером блока.
+*   Запросы не больше block_size обслуживаются блоком, большие - через LOG_CALLOC.
+*/
+struct slab
+{
+    allocator base;         ///< интерфейс аллокатора
+
+    size_t block_size;      ///< размер блока
+    void  *free_list;       ///< список свободных блоков
+    arena  chunks;          ///< арена, из которой нарезаются блоки
+};
+
+//================================================================================================================================
+
+extern const size_t ARENA_DEFAULT_BLOCK_SIZE;
+extern const size_t SLAB_DEFAULT_CHUNK_BLOCKS;
+
+//================================================================================================================================
+// ALLOCATOR
+//================================================================================================================================
+
+/**
+*   @brief Выделяет number * size байт, заполненных нулями.
+*
+*   @param alc    [in, out] - аллокатор (nullptr - LOG_CALLOC)
+*   @param number [in]      - количество элементов
+*   @param size   [in]      - размер элемента
+*
+*   @return указатель на выделенную память или nullptr в случае ошибки.
+*/
+void *allocator_calloc(allocator *const alc, const size_t number, const size_t size);
+
+/**
+*   @brief Меняет размер блока памяти, новые байты заполняются нулями.
+*
+*   @param alc      [in, out] - аллокатор (nullptr - LOG_RECALLOC)
+*   @param ptr      [in]      - блок (nullptr - выделить новый)
+*   @param old_size [in]      - текущий размер блока
+*   @param new_size [in]      - новый размер блока
+*
+*   @return указатель на блок нового размера или nullptr в случае ошибки (старый блок при этом не освобождается).
+*/
+void *allocator_recalloc(allocator *const alc, void *const ptr, const size_t old_size, const size_t new_size);
+
+/**
+*   @brief Освобождает блок памяти.
+*
+*   @param alc  [in, out] - аллокатор (nullptr - LOG_FREE)
+*   @param ptr  [in]      - блок
+*   @param size [in]      - размер блока
+*/
+void allocator_free(allocator *const alc, void *const ptr, const size_t size);
+
+//================================================================================================================================
+// ARENA
+//================================================================================================================================
+
+/**
+*   @brief Конструктор арены. Память под первый блок выделяется при первом запросе.
+*
+*   @param ar         [out] - указатель на арену
+*   @param block_size [in]  - размер первого блока (следующие блоки вдвое больше предыдущих)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool arena_ctor(arena *const ar, const size_t block_size = ARENA_DEFAULT_BLOCK_SIZE);
+
+/**
+*   @brief Деструктор арены. Возвращает все блоки системе.
+*
+*   @param _ar [in] - указатель на арену
+*/
+void arena_dtor(void *const _ar);
+
+/**
+*   @brief Освобождает всю память, выделенную из арены, за O(1). Блоки остаются у арены и используются повторно.
+*
+*   @param ar [in, out] - указатель на арену
+*/
+void arena_reset(arena *const ar);
+
+//================================================================================================================================
+// POOL
+//================================================================================================================================
+
+/**
+*   @brief Конструктор пула.
+*
+*   @param pl        [out] - указатель на пул
+*   @param slab_size [in]  - размер первого блока внутренней арены
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool pool_ctor(pool *const pl, const size_t slab_size = ARENA_DEFAULT_BLOCK_SIZE);
+
+/**
+*   @brief Деструктор пула. Возвращает системе память внутренней арены.
+*
+*   @param _pl [in] - указатель на пул
+*/
+void pool_dtor(void *const _pl);
+
+/**
+*   @brief Освобождает все блоки пула до 4096 байт за O(1).
+*
+*   @param pl [in, out] - указатель на пул
+*/
+void pool_reset(pool *const pl);
+
+//================================================================================================================================
+// SLAB
+//================================================================================================================================
+
+/**
+*   @brief Конструктор slab-а.
+*
+*   @param sl           [out] - указатель на slab
+*   @param block_size   [in]  - размер блока
+*   @param chunk_blocks [in]  - количество блоков в первом куске памяти (следующие куски вдвое больше)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool slab_ctor(slab *const sl, const size_t block_size, const size_t chunk_blocks = SLAB_DEFAULT_CHUNK_BLOCKS);
+
+/**
+*   @brief Деструктор slab-а. Возвращает системе все куски памяти.
+*
+*   @param _sl [in] - указатель на slab
+*/
+void slab_dtor(void *const _sl);
+
+/**
+*   @brief Освобождает все блоки slab-а за O(1).
+*
+*   @param sl [in, out] - указатель на slab
+*/
+void slab_reset(slab *const sl);
+
+/**
+*   @brief Переносит всю память src в dst. Выделенные из src блоки остаются на месте и дальше освобождаются через dst,
+*   свободные блоки и незанятый остаток текущего куска src переходят в список свободных блоков dst. src остается пустым.
+*
+*   @param dst [in, out] - slab, в который переносится память
+*   @param src [in, out] - slab с тем же размером блока
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool slab_absorb(slab *const dst, slab *const src);
+
+#endif // ALLOCATOR_H
@@ -108,6 +108,31 @@ void *array_begin(const array *const arr);
 */
 void *array_end(const array *const arr);
 
+/**
+*   @brief Сортирует элементы массива.
+*
+*   @param arr    [in, out] - указатель на массив
+*   @param el_cmp [in]      - указатель на функцию сравнения элементов (аналогично qsort)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*
+*   @see my_sort(void *, size_t, size_t, int (*)(const void *, const void *))
+*/
+bool array_sort(array *const arr, int (*el_cmp)(const void *el_1, const void *el_2));
+
+/**
+*   @brief Сортирует элементы массива в несколько потоков.
+*
+*   @param arr          [in, out] - указатель на массив
+*   @param el_cmp       [in]      - указатель на функцию сравнения элементов (аналогично qsort)
+*   @param thread_count [in]      - количество потоков (0 - по количеству доступных процессоров)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*
+*   @see my_parallel_sort(void *, size_t, size_t, int (*)(const void *, const void *), size_t)
+*/
+bool array_parallel_sort(array *const arr, int (*el_cmp)(const void *el_1, const void *el_2), const size_t thread_count = 0);
+
 /**
 *   @brief Дамп массива.
 *
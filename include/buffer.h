@@ -3,9 +3,35 @@
 #define BUFFER_H
 
 #include <stdlib.h>
+#include <stdint.h>
+
+#include "allocator.h"
 
 //================================================================================================================================
 
+/**
+*   @brief Откуда буфер берет память.
+*/
+typedef enum
+{
+    BUFFER_MODE_FIXED   ,   ///< память выделена аллокатором буфера
+    BUFFER_MODE_MAPPED  ,   ///< файл отображен в память только для чтения (buffer_map)
+    BUFFER_MODE_GROWABLE,   ///< память выделена аллокатором буфера и растет при записи (buffer_ctor_growable)
+    BUFFER_MODE_STREAM  ,   ///< окно, которое подчитывается из дескриптора по кускам (buffer_open, buffer_refill)
+}
+BUFFER_MODE_TYPE;
+
+/**
+*   @brief Подсказка ядру о порядке чтения отображенного файла (см. madvise).
+*/
+typedef enum
+{
+    BUFFER_ACCESS_NORMAL    ,   ///< без подсказки
+    BUFFER_ACCESS_SEQUENTIAL,   ///< файл читается подряд: агрессивное упреждающее чтение, прочитанные страницы можно вытеснять
+    BUFFER_ACCESS_RANDOM    ,   ///< файл читается в случайном порядке: упреждающее чтение отключено
+}
+BUFFER_ACCESS_TYPE;
+
 /**
 *   @brief Структура для хранения массива символов.
 */
@@ -14,10 +40,59 @@ struct buffer
     char  *beg;    ///< указатель на начало буфера
     char  *pos;    ///< указатель на текущую позицию
     size_t size;   ///< размер буфера
+
+    allocator       *alc;   ///< аллокатор буфера (nullptr - LOG_CALLOC)
+    BUFFER_MODE_TYPE mode;  ///< откуда буфер берет память
+
+    int    fd;              ///< дескриптор потокового буфера (-1 у остальных)
+    size_t capacity;        ///< емкость окна потокового буфера, включая завершающий '\0' (0 у остальных)
+    bool   is_eof;          ///< true, если потоковый буфер дочитал дескриптор до конца
+    bool   is_fd_owned;     ///< true, если буфер сам открыл дескриптор и закроет его в buffer_dtor
+};
+
+/**
+*   @brief Результат чтения числа из буфера (buffer_read_*).
+*/
+typedef enum
+{
+    BUFFER_READ_OK      ,   ///< число прочитано
+    BUFFER_READ_END     ,   ///< после пробельных символов данные закончились
+    BUFFER_READ_INVALID ,   ///< после пробельных символов нет числа, .pos указывает на первый непробельный символ
+    BUFFER_READ_OVERFLOW,   ///< число прочитано, но не помещается в тип: записано ближайшее представимое значение
+    BUFFER_READ_ERROR   ,   ///< невалидный буфер или аргументы
+}
+BUFFER_READ_STATUS;
+
+/**
+*   @brief Токен: участок буфера без копирования.
+*   Указатель смотрит внутрь буфера и действителен, пока буфер не изменился (у потокового буфера - до следующего чтения из него).
+*   Токен не завершается '\0'.
+*/
+struct buffer_token
+{
+    const char *ptr;    ///< начало токена
+    size_t      len;    ///< длина токена (в байтах)
+};
+
+static const size_t BUFFER_DELIMS_SIMD_MAX = 8; ///< сколько символов (включая '\0') множество разделителей может содержать для SIMD-поиска
+
+/**
+*   @brief Множество разделителей для buffer_next_token(), заранее разобранное buffer_delims_ctor().
+*/
+struct buffer_delims
+{
+    bool   is_delim[256];                   ///< is_delim[c] = true, если на символе c токен заканчивается (is_delim['\0'] = true - конец данных)
+    char   chars[BUFFER_DELIMS_SIMD_MAX];   ///< символы, на которых токен заканчивается, для SIMD-поиска
+    size_t chars_count;                     ///< кол-во символов в chars (0 - символов слишком много, поиск идет по таблице is_delim)
 };
 
 //================================================================================================================================
 
+extern const size_t DEFAULT_BUFFER_CAPACITY;
+extern const size_t DEFAULT_BUFFER_CHUNK_SIZE;
+
+//================================================================================================================================
+
 /**
 *   @brief Верификатор буфура.
 *   @return 0, если буфер валидный.
@@ -29,20 +104,87 @@ unsigned buffer_verify(const buffer *const buff);
 *
 *   @param buff      [out] - указатель на буфер
 *   @param buff_size [in]  - размер буфера (в байтах)
+*   @param alc       [in]  - аллокатор буфера (nullptr - LOG_CALLOC)
 *
 *   @return true в случае успеха, false в случае ошибки.
 */
-bool buffer_ctor(buffer *const buff, const size_t buff_size);
+bool buffer_ctor(buffer *const buff, const size_t buff_size, allocator *const alc = nullptr);
 
 /**
 *   @brief Конструктор буфера.
 *
 *   @param buff      [out] - указатель на буфер
 *   @param file_name [in]  - имя файла, которым заполнить буфер
+*   @param alc       [in]  - аллокатор буфера (nullptr - LOG_CALLOC)
 *
 *   @return true в случае успеха, false в случае ошибки.
 */
-bool buffer_ctor(buffer *const buff, const char *const file_name);
+bool buffer_ctor(buffer *const buff, const char *const file_name, allocator *const alc = nullptr);
+
+/**
+*   @brief Конструктор растущего буфера для записи.
+*   Запись в такой буфер никогда не обрезается: если места не хватает, емкость увеличивается геометрически
+*   (как минимум вдвое), и .beg / .pos могут переехать.
+*
+*   @param buff      [out] - указатель на буфер
+*   @param buff_size [in]  - начальная емкость буфера (в байтах, > 0)
+*   @param alc       [in]  - аллокатор буфера (nullptr - LOG_CALLOC)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool buffer_ctor_growable(buffer *const buff, const size_t buff_size = DEFAULT_BUFFER_CAPACITY, allocator *const alc = nullptr);
+
+/**
+*   @brief Конструктор буфера, отображающий файл в память только для чтения (mmap) вместо копирования.
+*   Как и у buffer_ctor(buffer *, const char *, allocator *), .size на 1 больше размера файла, и последний байт буфера - '\0'.
+*   Страницы файла подгружаются при первом обращении, поэтому конструктор работает за O(1) от размера файла.
+*   Писать в такой буфер нельзя.
+*
+*   @param buff      [out] - указатель на буфер
+*   @param file_name [in]  - имя файла
+*   @param access    [in]  - подсказка ядру о порядке чтения файла
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool buffer_map(buffer *const buff, const char *const file_name, const BUFFER_ACCESS_TYPE access = BUFFER_ACCESS_SEQUENTIAL);
+
+/**
+*   @brief Конструктор потокового буфера: окна размера chunk_size, которое заполняется из дескриптора вызовами buffer_refill().
+*   Работает с любыми дескрипторами, в том числе с каналами и stdin: размер файла заранее не нужен, память не зависит от него.
+*   Как и у файлового буфера, последний байт окна (.beg[.size - 1]) - '\0', то есть в окне .size - 1 прочитанных байт.
+*   Сразу после конструктора окно пустое.
+*
+*   @param buff       [out] - указатель на буфер
+*   @param fd         [in]  - дескриптор, открытый на чтение (буфер его не закрывает)
+*   @param chunk_size [in]  - сколько байт окно вмещает за раз (> 0)
+*   @param alc        [in]  - аллокатор окна (nullptr - LOG_CALLOC)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool buffer_open(buffer *const buff, const int fd, const size_t chunk_size = DEFAULT_BUFFER_CHUNK_SIZE, allocator *const alc = nullptr);
+
+/**
+*   @brief То же, что buffer_open(buffer *, int, size_t, allocator *), но открывает файл сам и закрывает его в buffer_dtor().
+*
+*   @param buff       [out] - указатель на буфер
+*   @param file_name  [in]  - имя файла
+*   @param chunk_size [in]  - сколько байт окно вмещает за раз (> 0)
+*   @param alc        [in]  - аллокатор окна (nullptr - LOG_CALLOC)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool buffer_open(buffer *const buff, const char *const file_name, const size_t chunk_size = DEFAULT_BUFFER_CHUNK_SIZE, allocator *const alc = nullptr);
+
+/**
+*   @brief Сдвигает окно потокового буфера: непрочитанные байты [.pos, конец данных) переезжают в начало окна,
+*   так что токен, разрезанный границей куска, остается целым. Затем окно дочитывается из дескриптора до конца
+*   или до EOF. Если непрочитанные байты занимают все окно, окно вдвое увеличивается.
+*
+*   @param buff [in, out] - указатель на потоковый буфер
+*
+*   @return true, если прочитан хотя бы один новый байт, false при EOF (.is_eof = true) или в случае ошибки.
+*/
+bool buffer_refill(buffer *const buff);
 
 /**
 *   @brief Создает буфер в динамической памяти.
@@ -92,7 +234,7 @@ char *buffer_back(const buffer *const buff);
 
 /**
 *   @brief Записывает данные по адресу .buff_pos.
-*   Если емкость буфера недостаточно велика, записывает, сколько поместится.
+*   Если емкость буфера недостаточно велика, записывает, сколько поместится. В отображенный файл и потоковый буфер писать нельзя.
 *
 *   @param buff      [in, out] - указатель на буфер
 *   @param data      [in]      - указатель на данные
@@ -102,6 +244,143 @@ char *buffer_back(const buffer *const buff);
 */
 bool buffer_write(buffer *const buff, const void *data, const size_t data_size);
 
+/**
+*   @brief Гарантирует, что после .pos есть хотя бы data_size свободных байт.
+*   Растущий буфер при необходимости увеличивает емкость, остальные буферы только проверяют, что место есть.
+*
+*   @param buff      [in, out] - указатель на буфер
+*   @param data_size [in]      - кол-во байт, которое нужно записать
+*
+*   @return true, если место есть, false в случае ошибки или нехватки места.
+*/
+bool buffer_reserve(buffer *const buff, const size_t data_size);
+
+/**
+*   @brief Форматированная запись (как printf) прямо в свободное место буфера, без промежуточной строки.
+*   После записанных символов ставится '\0', .pos указывает на него (следующая запись его перезапишет).
+*   Если буфер не растущий и места не хватает, ничего не записывает.
+*
+*   @param buff [in, out] - указатель на буфер
+*   @param fmt  [in]      - строка формата
+*
+*   @return true в случае успеха, false в случае ошибки или нехватки места.
+*/
+bool buffer_printf(buffer *const buff, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+*   @brief Записывает десятичное представление числа прямо в свободное место буфера.
+*   Если буфер не растущий и места не хватает, ничего не записывает.
+*
+*   @param buff [in, out] - указатель на буфер
+*   @param val  [in]      - число
+*
+*   @return true в случае успеха, false в случае ошибки или нехватки места.
+*/
+bool buffer_append_u64(buffer *const buff, const uint64_t val);
+
+/**
+*   @brief Записывает число в формате "%.17g" (однозначно читается обратно) прямо в свободное место буфера.
+*   То же, что buffer_printf(buff, "%.17g", val), в том числе завершающий '\0'.
+*
+*   @param buff [in, out] - указатель на буфер
+*   @param val  [in]      - число
+*
+*   @return true в случае успеха, false в случае ошибки или нехватки места.
+*/
+bool buffer_append_double(buffer *const buff, const double val);
+
+/**
+*   @brief Конструктор множества разделителей.
+*
+*   @param delims [out] - указатель на множество
+*   @param chars  [in]  - строка из символов-разделителей (например, " \t\n")
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool buffer_delims_ctor(buffer_delims *const delims, const char *const chars);
+
+/**
+*   @brief Читает строку, начинающуюся с .pos, без копирования. '\n' в строку не входит и пропускается.
+*
+*   Здесь и в остальных buffer_next_*: данные заканчиваются на первом '\0' или на конце буфера, потоковый буфер
+*   при необходимости подчитывается buffer_refill(), так что токены, разрезанные границей куска, возвращаются целиком.
+*
+*   @param buff [in, out] - указатель на буфер
+*   @param line [out]     - строка
+*
+*   @return true, если строка прочитана, false, если данные закончились, или в случае ошибки.
+*/
+bool buffer_next_line(buffer *const buff, buffer_token *const line);
+
+/**
+*   @brief Пропускает разделители и читает токен до следующего разделителя без копирования.
+*   Следующий за токеном разделитель пропускается.
+*
+*   @param buff   [in, out] - указатель на буфер
+*   @param delims [in]      - множество разделителей
+*   @param token  [out]     - токен
+*
+*   @return true, если токен прочитан, false, если данные закончились, или в случае ошибки.
+*/
+bool buffer_next_token(buffer *const buff, const buffer_delims *const delims, buffer_token *const token);
+
+/**
+*   @brief Пропускает пробельные символы и читает запись целого числа ([+-]?[0-9]+) без копирования и без перевода в число.
+*
+*   @param buff  [in, out] - указатель на буфер
+*   @param token [out]     - запись числа
+*
+*   @return true, если число прочитано, false, если после пробельных символов нет числа, или в случае ошибки.
+*   В случае неудачи .pos указывает на первый непробельный символ.
+*/
+bool buffer_next_int(buffer *const buff, buffer_token *const token);
+
+/**
+*   @brief Пропускает пробельные символы и читает десятичную запись вещественного числа ([+-]?, цифры с необязательной точкой,
+*   необязательная экспонента [eE][+-]?[0-9]+) без копирования и без перевода в число.
+*
+*   @param buff  [in, out] - указатель на буфер
+*   @param token [out]     - запись числа
+*
+*   @return true, если число прочитано, false, если после пробельных символов нет числа, или в случае ошибки.
+*   В случае неудачи .pos указывает на первый непробельный символ.
+*/
+bool buffer_next_double(buffer *const buff, buffer_token *const token);
+
+/**
+*   @brief Пропускает пробельные символы и читает целое число ([+-]?[0-9]+), сдвигая .pos за него.
+*   Не зависит от локали и не использует errno, цифры разбираются по 8 за шаг (SWAR).
+*
+*   @param buff [in, out] - указатель на буфер
+*   @param val  [out]     - число (при переполнении - INT64_MIN или INT64_MAX)
+*
+*   @return BUFFER_READ_OK в случае успеха, иначе см. BUFFER_READ_STATUS.
+*/
+BUFFER_READ_STATUS buffer_read_i64(buffer *const buff, int64_t *const val);
+
+/**
+*   @brief То же, что buffer_read_i64(), для беззнакового числа ([+]?[0-9]+, минус - BUFFER_READ_INVALID).
+*
+*   @param buff [in, out] - указатель на буфер
+*   @param val  [out]     - число (при переполнении - UINT64_MAX)
+*
+*   @return BUFFER_READ_OK в случае успеха, иначе см. BUFFER_READ_STATUS.
+*/
+BUFFER_READ_STATUS buffer_read_u64(buffer *const buff, uint64_t *const val);
+
+/**
+*   @brief Пропускает пробельные символы и читает вещественное число в той же записи, что и buffer_next_double(), сдвигая .pos за него.
+*   Результат - ближайший к записи double (округление к четному, как у strtod), без зависимости от локали и без errno.
+*   Числа до 19 значащих цифр переводятся алгоритмом Эйзеля-Лемира, для более длинных записей в редких неоднозначных
+*   случаях используется strtod.
+*
+*   @param buff [in, out] - указатель на буфер
+*   @param val  [out]     - число (при переполнении - бесконечность со знаком числа; слишком малые числа округляются до нуля)
+*
+*   @return BUFFER_READ_OK в случае успеха, иначе см. BUFFER_READ_STATUS.
+*/
+BUFFER_READ_STATUS buffer_read_double(buffer *const buff, double *const val);
+
 /**
 *   @brief Дамп буфера в виде последовательности символов.
 *
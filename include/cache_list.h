@@ -0,0 +1,421 @@
+/** @file */
+#ifndef CACHE_LIST_H
+#define CACHE_LIST_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+//================================================================================================================================
+
+/**
+*   @brief Тип индекса вершины кэш-листа.
+*   По умолчанию 32-битный: вершина занимает 8 байт, и в кэш-линию помещается 8 вершин. Для кэш-листов емкостью больше
+*   CACHE_LIST_MAX_CAPACITY нужно собрать библиотеку и программу с CACHE_LIST_WIDE_INDEX.
+*/
+#ifdef CACHE_LIST_WIDE_INDEX
+typedef size_t   cache_list_index;
+#else
+typedef uint32_t cache_list_index;
+#endif
+
+/**
+*   @brief Вершина cache-friendly листа.
+*   Признак занятости вершины хранится отдельно, в битовой карте cache_list.busy: при обходе нужны только связи.
+*/
+struct cache_list_node
+{
+    cache_list_index prev;  ///< индекс предыдущей вершины листа
+    cache_list_index next;  ///< индекс следующей вершины листа
+};
+
+/**
+*   @brief Структура данных cache-friendly лист (кэш-лист).
+*   Вершины и элементы лежат в двух массивах, связи между вершинами - индексы в этих массивах. Нулевая вершина - фиктивная.
+*
+*   Линеаризованность (.is_linearized) сохраняется при push_back / pop_back и нарушается вставкой или удалением не в конце.
+*   Пока кэш-лист линеаризован, поиск вершины по порядковому номеру (get, insert, erase, курсоры) работает за O(1).
+*/
+struct cache_list
+{
+    cache_list_node *fictional;             ///< массив вершин (первая вершина фиктивная)
+    void            *data;                  ///< массив элементов (элемент вершины i лежит в слоте i)
+    uint64_t        *busy;                  ///< битовая карта занятых вершин (бит i - вершина i)
+
+    size_t size;                            ///< количество элементов в кэш-листе
+    size_t capacity;                        ///< емкость массивов .fictional и .data
+
+    size_t el_free;                         ///< индекс первой свободной вершины (.capacity, если свободных нет)
+    size_t el_size;                         ///< размер элемента кэш-листа
+
+    void (*el_dtor) (      void *const);    ///< указатель на dtor элемента кэш-листа
+    void (*el_dump) (const void *const);    ///< указатель на dump элемента кэш-листа
+
+    bool is_linearized;                     ///< true, если i-й элемент кэш-листа лежит в слоте i + 1 (обход - проход по массиву)
+};
+
+/**
+*   @brief Курсор кэш-листа: индекс вершины в массиве и ее порядковый номер в кэш-листе.
+*   Курсор хранит индекс, а не указатель, поэтому переживает реаллокацию кэш-листа при вставке через курсор.
+*   Любые изменения кэш-листа не через этот курсор его инвалидируют.
+*/
+struct cache_list_cursor
+{
+    cache_list *lst;    ///< кэш-лист
+    size_t      ind;    ///< индекс текущей вершины в массиве (0 - фиктивная, курсор за концом кэш-листа)
+    size_t      pos;    ///< порядковый номер текущей вершины (.size, если курсор за концом кэш-листа)
+};
+
+//================================================================================================================================
+
+extern const size_t DEFAULT_CACHE_LIST_CAPACITY;
+extern const size_t CACHE_LIST_MAX_CAPACITY;
+
+//================================================================================================================================
+
+/**
+*   @brief Верификатор кэш-листа.
+*   @return 0, если кэш-лист валидный.
+*/
+unsigned cache_list_verify(const cache_list *const lst);
+
+/**
+*   @brief Конструктор кэш-листа.
+*
+*   @param lst           [out] - указатель на кэш-лист
+*   @param el_size       [in]  - размер элемента кэш-листа (в байтах)
+*   @param el_dtor       [in]  - указатель на dtor элемента кэш-листа
+*   @param el_dump       [in]  - указатель на dump элемента кэш-листа
+*   @param list_capacity [in]  - начальная емкость кэш-листа (> 1, <= CACHE_LIST_MAX_CAPACITY)
+*
+*   @return true, если удалось создать кэш-лист, false - иначе.
+*/
+bool cache_list_ctor(cache_list *const lst, const size_t el_size, void (*el_dtor) (      void *const) = nullptr,
+                                                                  void (*el_dump) (const void *const) = nullptr,
+                                                                  const size_t list_capacity          = DEFAULT_CACHE_LIST_CAPACITY);
+
+/**
+*   @brief Создает кэш-лист в динамической памяти.
+*
+*   @param el_size       [in] - размер элемента кэш-листа (в байтах)
+*   @param el_dtor       [in] - указатель на dtor элемента кэш-листа
+*   @param el_dump       [in] - указатель на dump элемента кэш-листа
+*   @param list_capacity [in] - начальная емкость кэш-листа (> 1, <= CACHE_LIST_MAX_CAPACITY)
+*
+*   @return указатель на созданный кэш-лист или nullptr в случае ошибки.
+*/
+cache_list *cache_list_new(const size_t el_size, void (*el_dtor) (      void *const) = nullptr,
+                                                 void (*el_dump) (const void *const) = nullptr,
+                                                 const size_t list_capacity          = DEFAULT_CACHE_LIST_CAPACITY);
+
+/**
+*   @brief Деструктор кэш-листа.
+*
+*   @param _lst [in] - указатель на кэш-лист
+*/
+void cache_list_dtor(void *const _lst);
+
+/**
+*   @brief Деструктор кэш-листа в динамической памяти.
+*
+*   @param _lst [in] - указатель на кэш-лист
+*/
+void cache_list_delete(void *const _lst);
+
+/**
+*   @brief Кладет элемент в кэш-лист.
+*
+*   @param lst  [in, out] - указатель на кэш-лист
+*   @param data [in]      - указатель на элемент
+*   @param pos  [in]      - порядковый номер, на который поставить элемент
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_insert(cache_list *const lst, const void *const data, const size_t pos);
+
+/**
+*   @brief Кладет элемент в начало кэш-листа.
+*
+*   @param lst  [in, out] - указатель на кэш-лист
+*   @param data [in]      - указатель на элемент
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_push_front(cache_list *const lst, const void *const data);
+
+/**
+*   @brief Кладет элемент в конец кэш-листа.
+*
+*   @param lst  [in, out] - указатель на кэш-лист
+*   @param data [in]      - указатель на элемент
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_push_back(cache_list *const lst, const void *const data);
+
+/**
+*   @brief Кладет n элементов подряд в кэш-лист, начиная с порядкового номера pos. Память перевыделяется не больше одного раза.
+*
+*   @param lst  [in, out] - указатель на кэш-лист
+*   @param data [in]      - указатель на массив из n элементов
+*   @param n    [in]      - количество элементов
+*   @param pos  [in]      - порядковый номер, на который поставить первый элемент
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_insert_n(cache_list *const lst, const void *const data, const size_t n, const size_t pos);
+
+/**
+*   @brief Кладет n элементов в конец кэш-листа. Память перевыделяется не больше одного раза.
+*
+*   @param lst  [in, out] - указатель на кэш-лист
+*   @param data [in]      - указатель на массив из n элементов
+*   @param n    [in]      - количество элементов
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_push_back_n(cache_list *const lst, const void *const data, const size_t n);
+
+/**
+*   @brief Увеличивает емкость кэш-листа так, чтобы в нем поместилось el_count элементов без перевыделения памяти.
+*
+*   @param lst      [in, out] - указатель на кэш-лист
+*   @param el_count [in]      - количество элементов
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_reserve(cache_list *const lst, const size_t el_count);
+
+/**
+*   @brief Удаляет элемент из кэш-листа.
+*
+*   @param lst         [in, out] - указатель на кэш-лист
+*   @param pos         [in]      - порядковый номер удаляемого элемента
+*   @param erased_data [out]     - указатель, по которому скопировать содержимое удаляемой вершины (nullptr по умолчанию)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_erase(cache_list *const lst, const size_t pos, void *const erased_data = nullptr);
+
+/**
+*   @brief Удаляет элемент из начала кэш-листа.
+*
+*   @param lst         [in, out] - указатель на кэш-лист
+*   @param erased_data [out]     - указатель, по которому скопировать содержимое удаляемой вершины (nullptr по умолчанию)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_pop_front(cache_list *const lst, void *const erased_data = nullptr);
+
+/**
+*   @brief Удаляет элемент из конца кэш-листа.
+*
+*   @param lst         [in, out] - указатель на кэш-лист
+*   @param erased_data [out]     - указатель, по которому скопировать содержимое удаляемой вершины (nullptr по умолчанию)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_pop_back(cache_list *const lst, void *const erased_data = nullptr);
+
+/**
+*   @brief Удаляет из кэш-листа все элементы, для которых el_pred возвращает true, за один проход.
+*   Удаленные вершины возвращаются в цикл свободных вершин одной цепочкой.
+*
+*   @param lst     [in, out] - указатель на кэш-лист
+*   @param el_pred [in]      - предикат: true, если элемент нужно удалить
+*
+*   @return количество удаленных элементов (0 в случае ошибки).
+*/
+size_t cache_list_erase_if(cache_list *const lst, bool (*el_pred)(const void *el));
+
+/**
+*   @brief Показывает содержимое элемента кэш-листа.
+*
+*   @param lst [in] - указатель на кэш-лист
+*   @param pos [in] - порядковый номер элемента
+*
+*   @return указатель на элемент в случае успеха, nullptr в случае ошибки.
+*/
+void *cache_list_get(const cache_list *const lst, const size_t pos);
+
+/**
+*   @brief Показывает содержимое первого элемента кэш-листа.
+*
+*   @param lst [in] - указатель на кэш-лист
+*
+*   @return указатель на первый элемент в случае успеха, nullptr в случае ошибки.
+*/
+void *cache_list_front(const cache_list *const lst);
+
+/**
+*   @brief Показывает содержимое последнего элемента кэш-листа.
+*
+*   @param lst [in] - указатель на кэш-лист
+*
+*   @return указатель на последний элемент в случае успеха, nullptr в случае ошибки.
+*/
+void *cache_list_back(const cache_list *const lst);
+
+/**
+*   @brief Ищет элемент в кэш-листе, обходя его по связям.
+*
+*   @param lst    [in] - указатель на кэш-лист
+*   @param target [in] - указатель на элемент, который нужно найти
+*   @param el_cmp [in] - указатель на функцию сравнения элементов, которая возвращает 0, если элементы равны
+*
+*   @return указатель на первое вхождение найденного элемента или nullptr, если его в кэш-листе нет.
+*/
+void *cache_list_find(const cache_list *const lst, const void *const target, int (*el_cmp)(const void *el_1, const void *el_2));
+
+/**
+*   @brief Ищет элемент в кэш-листе, проходя массив .data подряд и пропуская свободные слоты по битовой карте .busy.
+*   Находит первое вхождение в порядке массива. Оно совпадает с первым вхождением в порядке кэш-листа,
+*   если кэш-лист линеаризован.
+*
+*   @param lst    [in]  - указатель на кэш-лист
+*   @param target [in]  - указатель на элемент, который нужно найти
+*   @param el_cmp [in]  - указатель на функцию сравнения элементов, которая возвращает 0, если элементы равны
+*   @param pos    [out] - указатель, по которому положить порядковый номер найденного элемента (nullptr по умолчанию)
+*
+*   @return указатель на найденный элемент или nullptr, если его в кэш-листе нет.
+*/
+void *cache_list_find_through(const cache_list *const lst, const void *const target, int (*el_cmp)(const void *el_1, const void *el_2),
+                                                                                    size_t *const pos = nullptr);
+
+/**
+*   @brief То же, что cache_list_find_through(), но элементы сравниваются побайтово (как memcmp).
+*   Для элементов размера 1, 2, 4 и 8 байт сравнивает по 16 слотов за раз с помощью SSE2.
+*
+*   @param lst    [in]  - указатель на кэш-лист
+*   @param target [in]  - указатель на элемент, который нужно найти
+*   @param pos    [out] - указатель, по которому положить порядковый номер найденного элемента (nullptr по умолчанию)
+*
+*   @return указатель на найденный элемент или nullptr, если его в кэш-листе нет.
+*/
+void *cache_list_find_through_bytes(const cache_list *const lst, const void *const target, size_t *const pos = nullptr);
+
+/**
+*   @brief Перенумеровывает занятые вершины в порядке кэш-листа: i-й элемент переезжает в слот i + 1, свободные вершины -
+*   в слоты после .size. Работает на месте за O(size), без выделения памяти. После вызова .is_linearized = true,
+*   и обход кэш-листа - последовательный проход по массиву .data. Для линеаризованного кэш-листа ничего не делает.
+*   Указатели на элементы и курсоры кэш-листа инвалидируются.
+*
+*   @param lst [in, out] - указатель на кэш-лист
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_compact(cache_list *const lst);
+
+/**
+*   @brief Сортирует кэш-лист, физически переставляя элементы в массиве .data.
+*   Кэш-лист линеаризуется cache_list_compact(), после чего слоты 1..size сортируются на месте функцией my_sort().
+*   Сортировка неустойчивая. Указатели на элементы и курсоры кэш-листа инвалидируются.
+*
+*   @param lst    [in, out] - указатель на кэш-лист
+*   @param el_cmp [in]      - функция сравнения элементов (аналогично qsort)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_sort(cache_list *const lst, int (*el_cmp)(const void *el_1, const void *el_2));
+
+/**
+*   @brief Ставит курсор на элемент кэш-листа.
+*
+*   @param cur [out] - указатель на курсор
+*   @param lst [in]  - указатель на кэш-лист
+*   @param pos [in]  - порядковый номер элемента (.size - за концом кэш-листа)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_cursor_ctor(cache_list_cursor *const cur, cache_list *const lst, const size_t pos = 0);
+
+/**
+*   @brief Возвращает указатель на текущий элемент курсора.
+*
+*   @param cur [in] - указатель на курсор
+*
+*   @return указатель на элемент или nullptr, если курсор за концом кэш-листа или в случае ошибки.
+*/
+void *cache_list_cursor_get(const cache_list_cursor *const cur);
+
+/**
+*   @brief Сдвигает курсор на step элементов (step < 0 - назад).
+*
+*   @param cur  [in, out] - указатель на курсор
+*   @param step [in]      - сдвиг
+*
+*   @return true в случае успеха, false, если курсор вышел бы за границы [0, .size] (курсор при этом не двигается).
+*/
+bool cache_list_cursor_advance(cache_list_cursor *const cur, const long step = 1);
+
+/**
+*   @brief Переставляет курсор на элемент с заданным номером, начиная обход от ближайшей из точек: курсор, начало, конец.
+*   Для линеаризованного кэш-листа работает за O(1).
+*
+*   @param cur [in, out] - указатель на курсор
+*   @param pos [in]      - порядковый номер элемента (.size - за концом кэш-листа)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_cursor_seek(cache_list_cursor *const cur, const size_t pos);
+
+/**
+*   @brief Вставляет элемент перед текущим элементом курсора. Курсор остается на прежнем элементе, его номер растет на 1.
+*
+*   @param cur  [in, out] - указатель на курсор
+*   @param data [in]      - указатель на элемент
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool cache_list_cursor_insert_before(cache_list_cursor *const cur, const void *const data);
+
+/**
+*   @brief Удаляет текущий элемент курсора. Курсор переходит на следующий элемент с тем же номером.
+*
+*   @param cur         [in, out] - указатель на курсор
+*   @param erased_data [out]     - указатель, по которому скопировать содержимое удаляемой вершины (nullptr по умолчанию)
+*
+*   @return true в случае успеха, false в случае ошибки (в том числе, если курсор за концом кэш-листа).
+*/
+bool cache_list_cursor_erase(cache_list_cursor *const cur, void *const erased_data = nullptr);
+
+/**
+*   @brief Дамп кэш-листа.
+*
+*   @param _lst [in] - указатель на кэш-лист
+*/
+void cache_list_dump(const void *const _lst);
+
+//================================================================================================================================
+
+#if defined(NVERIFY)
+#define CACHE_LIST_NVERIFY
+#endif
+
+#if defined(NDEBUG)
+#define CACHE_LIST_NDEBUG
+#endif
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef CACHE_LIST_NVERIFY
+#define CACHE_LIST_VERIFY(lst, ret_val)     \
+    if (cache_list_verify(lst) != 0)        \
+    {                                       \
+    $o  return ret_val;                     \
+    }
+#else
+#define CACHE_LIST_VERIFY(lst, ret_val)
+#endif
+
+#ifndef CACHE_LIST_NDEBUG
+#define CACHE_LIST_ASSERT(lst)                              \
+    if (cache_list_verify(lst) != 0)                        \
+    {                                                       \
+        fprintf(stderr, "CACHE LIST ASSERTION FAILED\n");   \
+        abort();                                            \
+    }
+#else
+#define CACHE_LIST_ASSERT(lst)
+#endif
+
+#endif // CACHE_LIST_H
@@ -4,6 +4,8 @@
 
 #include <stdlib.h>
 
+#include "allocator.h"
+
 //================================================================================================================================
 
 /**
@@ -15,6 +17,9 @@ struct list_node
     list_node  *next;   ///< указатель на следующую вершину листа
 };
 
+struct list_index;
+struct list_slab;
+
 /**
 *   @brief Структура данных лист.
 */
@@ -27,10 +32,36 @@ struct list
 
     void (*el_dtor) (      void *const);    ///< указатель на dtor элемента листа
     void (*el_dump) (const void *const);    ///< указатель на dump элемента листа
+
+    allocator *alc;                         ///< аллокатор вершин листа
+    list_slab *own_slab;                    ///< собственный slab вершин листа (nullptr, если аллокатор передан в конструктор)
+
+    list_index *index;                      ///< позиционный индекс листа (nullptr, если индекс выключен)
+};
+
+/**
+*   @brief Курсор листа: вершина и ее порядковый номер.
+*   Позволяет обходить лист по номерам за O(1) на шаг вместо O(n) на каждый list_get().
+*   Курсор остается валидным при изменениях листа через этот курсор; любые другие вставки и удаления его инвалидируют.
+*/
+struct list_cursor
+{
+    list      *lst;     ///< лист
+    list_node *node;    ///< текущая вершина (фиктивная, если курсор за концом листа)
+    size_t     pos;     ///< порядковый номер текущей вершины (lst->size, если курсор за концом листа)
 };
 
 //================================================================================================================================
 
+/**
+*   @brief Размер вершины листа с элементом размера el_size.
+*   Листы с одинаковым el_size могут делить один slab: slab_ctor(&sl, list_node_size(el_size)).
+*/
+inline size_t list_node_size(const size_t el_size)
+{
+    return sizeof(list_node) + el_size;
+}
+
 /**
 *   @brief Верификатор листа.
 *   @return 0, если лист валидный.
@@ -39,16 +70,23 @@ unsigned list_verify(const list *const lst);
 
 /**
 *   @brief Конструктор листа.
+*   Без аллокатора лист выделяет вершины из собственного slab-а. Листы с собственными slab-ами при первом переносе вершин
+*   между ними (list_splice(), list_concat(), list_merge()) объединяют slab-ы в общую группу, память которой возвращается
+*   системе вместе с последним листом группы.
 *
 *   @param lst     [out] - указатель на лист
 *   @param el_size [in]  - размер элемента листа (в байтах)
 *   @param el_dtor [in]  - указатель на dtor элемента листа
 *   @param el_dump [in]  - указатель на dump элемента листа
+*   @param alc     [in]  - аллокатор вершин листа (nullptr - собственный slab листа)
 *
 *   @return true, если удалось создать лист, false - иначе.
+*
+*   @see list_node_size()
 */
 bool list_ctor(list *const lst, const size_t el_size, void (*el_dtor) (      void *const) = nullptr,
-                                                      void (*el_dump) (const void *const) = nullptr);
+                                                      void (*el_dump) (const void *const) = nullptr,
+                                                      allocator *alc                      = nullptr);
 
 /**
 *   @brief Создает лист в динамической памяти.
@@ -56,11 +94,13 @@ bool list_ctor(list *const lst, const size_t el_size, void (*el_dtor) (      voi
 *   @param el_size [in] - размер элемента листа (в байтах)
 *   @param el_dtor [in] - указатель на dtor элемента листа
 *   @param el_dump [in] - указатель на dump элемента листа
+*   @param alc     [in] - аллокатор вершин листа (nullptr - собственный slab листа)
 *
 *   @return указатель на созданный лист или nullptr в случае ошибки.
 */
 list *list_new(const size_t el_size, void (*el_dtor) (      void *const) = nullptr,
-                                     void (*el_dump) (const void *const) = nullptr);
+                                     void (*el_dump) (const void *const) = nullptr,
+                                     allocator *alc                      = nullptr);
 
 /**
 *   @brief Деструктор листа.
@@ -76,6 +116,19 @@ void list_dtor(void *const _lst);
 */
 void list_delete(void *const _lst);
 
+/**
+*   @brief Включает или выключает позиционный индекс листа.
+*   Индексированный лист обновляет декартово дерево по неявному ключу при каждом изменении, поэтому доступ, вставка и удаление
+*   по порядковому номеру работают за O(log n) вместо O(n). Цена - одна вершина дерева на элемент и O(log n) на push/pop.
+*   Включение строит индекс за O(n), выключение освобождает его.
+*
+*   @param lst        [in, out] - указатель на лист
+*   @param is_indexed [in]      - true - включить индекс, false - выключить
+*
+*   @return true в случае успеха, false в случае ошибки (лист при этом остается без индекса).
+*/
+bool list_set_indexed(list *const lst, const bool is_indexed);
+
 /**
 *   @brief Удаляет все содержимое листа.
 *
@@ -251,6 +304,120 @@ bool list_replace(const list *const lst, const size_t src_pos, const size_t dest
 */
 bool list_replace(const list *const lst, const void *src_el, const size_t src_pos, const size_t dest_pos);
 
+/**
+*   @brief Переносит элементы [first, last) листа src на позицию pos листа dst (перед элементом с номером pos).
+*   Если у листов общий аллокатор (в том числе, если это один лист) или оба листа выделяют вершины из собственных slab-ов,
+*   вершины перевешиваются без копирования элементов и без обращений к аллокатору: O(1) после поиска вершин по номерам
+*   (O(log n) для индексированных листов), плюс O(k) на обновление индекса dst. Только у листов с разными явно переданными
+*   аллокаторами элементы побайтово копируются в новые вершины dst (el_dtor не вызывается).
+*
+*   @param dst   [in, out] - лист, в который переносятся элементы
+*   @param pos   [in]      - порядковый номер в dst, перед которым встанут элементы (для одного листа - вне (first, last))
+*   @param src   [in, out] - лист, из которого переносятся элементы
+*   @param first [in]      - номер первого переносимого элемента src
+*   @param last  [in]      - номер элемента src, следующего за последним переносимым
+*
+*   @return true в случае успеха, false в случае ошибки (тогда оба листа не меняются).
+*/
+bool list_splice(list *const dst, const size_t pos, list *const src, const size_t first, const size_t last);
+
+/**
+*   @brief Переносит все элементы src в конец dst. Эквивалентно list_splice(dst, dst->size, src, 0, src->size).
+*
+*   @param dst [in, out] - лист, в конец которого переносятся элементы
+*   @param src [in, out] - лист, из которого переносятся элементы (становится пустым)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool list_concat(list *const dst, list *const src);
+
+/**
+*   @brief Сливает отсортированный лист src в отсортированный лист dst за O(dst->size + src->size).
+*   Слияние устойчивое: из равных элементов элементы dst идут первыми. Вершины перевешиваются так же, как в list_splice().
+*   Индексы листов перестраиваются за O(n).
+*
+*   @param dst    [in, out] - отсортированный лист, в который сливаются элементы
+*   @param src    [in, out] - отсортированный лист, из которого сливаются элементы (становится пустым)
+*   @param el_cmp [in]      - функция сравнения элементов (< 0, 0, > 0)
+*
+*   @return true в случае успеха, false в случае ошибки (тогда оба листа не меняются).
+*/
+bool list_merge(list *const dst, list *const src, int (*el_cmp)(const void *el_1, const void *el_2));
+
+/**
+*   @brief Сортирует лист восходящей сортировкой слиянием за O(n log n).
+*   Вершины перевешиваются без копирования элементов и без обращений к аллокатору. Сортировка устойчивая.
+*   Индекс листа, если он включен, перестраивается за O(n).
+*
+*   @param lst    [in, out] - указатель на лист
+*   @param el_cmp [in]      - функция сравнения элементов (аналогично qsort)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool list_sort(list *const lst, int (*el_cmp)(const void *el_1, const void *el_2));
+
+/**
+*   @brief Ставит курсор на элемент листа.
+*
+*   @param cur [out] - указатель на курсор
+*   @param lst [in]  - указатель на лист
+*   @param pos [in]  - порядковый номер элемента (lst->size - за концом листа)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool list_cursor_ctor(list_cursor *const cur, list *const lst, const size_t pos = 0);
+
+/**
+*   @brief Возвращает указатель на текущий элемент курсора.
+*
+*   @param cur [in] - указатель на курсор
+*
+*   @return указатель на элемент или nullptr, если курсор за концом листа или в случае ошибки.
+*/
+void *list_cursor_get(const list_cursor *const cur);
+
+/**
+*   @brief Сдвигает курсор на step элементов (step < 0 - назад).
+*
+*   @param cur  [in, out] - указатель на курсор
+*   @param step [in]      - сдвиг
+*
+*   @return true в случае успеха, false, если курсор вышел бы за границы [0, lst->size] (курсор при этом не двигается).
+*/
+bool list_cursor_advance(list_cursor *const cur, const long step = 1);
+
+/**
+*   @brief Переставляет курсор на элемент с заданным номером.
+*   Идет от ближайшей из трех точек: текущей позиции курсора, начала или конца листа. Если у листа включен индекс,
+*   дальние переходы идут через него.
+*
+*   @param cur [in, out] - указатель на курсор
+*   @param pos [in]      - порядковый номер элемента (lst->size - за концом листа)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool list_cursor_seek(list_cursor *const cur, const size_t pos);
+
+/**
+*   @brief Вставляет элемент перед текущим элементом курсора. Курсор остается на прежнем элементе, его номер растет на 1.
+*
+*   @param cur  [in, out] - указатель на курсор
+*   @param data [in]      - указатель на элемент
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool list_cursor_insert_before(list_cursor *const cur, const void *const data);
+
+/**
+*   @brief Удаляет текущий элемент курсора. Курсор переходит на следующий элемент с тем же номером.
+*
+*   @param cur         [in, out] - указатель на курсор
+*   @param erased_data [out]     - указатель, по которому скопировать содержимое удаляемой вершины (nullptr по умолчанию)
+*
+*   @return true в случае успеха, false в случае ошибки (в том числе, если курсор за концом листа).
+*/
+bool list_cursor_erase(list_cursor *const cur, void *const erased_data = nullptr);
+
 /**
 *   @brief Дамп листа.
 *
@@ -4,8 +4,30 @@
 
 #include <stdlib.h>
 
+#include "allocator.h"
+
 //================================================================================================================================
 
+/**
+*   @brief Политика изменения емкости стека.
+*
+*   При переполнении емкость становится равной capacity * grow_num / grow_den + grow_chunk, так что множитель 2 - это {2, 1, 0},
+*   множитель 1.5 - {3, 2, 0}, а рост фиксированными порциями по k элементов - {1, 1, k}.
+*
+*   При удалении элементов емкость уменьшается до size * shrink_slack, как только size * shrink_ratio <= capacity.
+*   Условие shrink_slack < shrink_ratio дает гистерезис: после уменьшения стек не переполняется и не уменьшается снова сразу же.
+*   shrink_ratio = 0 отключает автоматическое уменьшение.
+*/
+struct stack_growth
+{
+    size_t grow_num;        ///< числитель множителя роста
+    size_t grow_den;        ///< знаменатель множителя роста
+    size_t grow_chunk;      ///< фиксированная добавка к емкости при росте
+
+    size_t shrink_ratio;    ///< во сколько раз емкость должна превышать размер, чтобы стек уменьшился (0 - никогда)
+    size_t shrink_slack;    ///< во сколько раз емкость превышает размер после уменьшения
+};
+
 /**
 *   @brief Структура данных стек.
 */
@@ -17,16 +39,42 @@ struct stack
     size_t     size;        ///< размер стека (количество элементов в стеке)
     size_t capacity;        ///< емкость стека (максимальное количество элементов, которое может храниться в стеке)
 
+    size_t       min_capacity;  ///< емкость, ниже которой стек не уменьшается автоматически
+    stack_growth growth;        ///< политика изменения емкости
+
+    void  *inline_data;         ///< встроенный буфер, в котором хранятся элементы, пока их не больше inline_capacity (nullptr - буфера нет)
+    size_t inline_capacity;     ///< емкость встроенного буфера
+
+    allocator *alc;             ///< аллокатор массива с элементами (nullptr - LOG_CALLOC)
+
     const void *el_poison;  ///< указатель на POISON-элемент стека
 
     void (*el_dtor) (      void *const el);    ///< указатель на dtor элемента стека
     void (*el_dump) (const void *const el);    ///< указатель на dump элемента стека
 };
 
+/**
+*   @brief Стек со встроенным буфером на N элементов типа T.
+*   Работа с ним идет через поле base обычными функциями стека. Пока элементов не больше N, куча не используется.
+*   Структуру нельзя копировать и перемещать, пока стек не разрушен: base.data может указывать на buf.
+*
+*   @see stack_ctor_inline()
+*/
+template <typename T, size_t N>
+struct small_stack
+{
+    stack base;                                     ///< стек
+
+    alignas(T) unsigned char buf[N * sizeof(T)];    ///< встроенный буфер
+};
+
 //================================================================================================================================
 
 extern const size_t DEFAULT_STACK_CAPACITY;
 
+extern const stack_growth DEFAULT_STACK_GROWTH; ///< рост в 2 раза, уменьшение вдвое при заполненности не больше 1/4
+extern const stack_growth STACK_GROWTH_X1_5;    ///< рост в 1.5 раза, уменьшение вдвое при заполненности не больше 1/4
+
 //================================================================================================================================
 
 /**
@@ -44,6 +92,7 @@ unsigned stack_verify(const stack *const stk);
 *   @param el_dtor        [in]  - указатель на dtor элемента стека
 *   @param el_dump        [in]  - указатель на dump элемента стека
 *   @param stack_capacity [in]  - начальная емкость стека
+*   @param alc            [in]  - аллокатор массива с элементами (nullptr - LOG_CALLOC)
 *
 *   @return true, если удалось создать стек, false - иначе.
 */
@@ -51,7 +100,50 @@ bool stack_ctor(stack *const stk, const size_t el_size, const void *const el_poi
                                                               void (     *el_dtor  )(      void *const) = nullptr,
                                                               void (     *el_dump  )(const void *const) = nullptr,
 
-                                                              const size_t stack_capacity = DEFAULT_STACK_CAPACITY);
+                                                              const size_t stack_capacity = DEFAULT_STACK_CAPACITY,
+                                                              allocator   *alc            = nullptr);
+
+/**
+*   @brief Конструктор стека со встроенным буфером.
+*   Пока элементов не больше buffer_capacity, они хранятся в buffer и динамическая память не выделяется.
+*   При переполнении элементы переносятся в динамическую память, а когда емкость уменьшается до buffer_capacity - обратно в buffer.
+*   Буфер должен жить дольше стека.
+*
+*   @param stk             [out] - указатель на стек
+*   @param el_size         [in]  - размер элемента стека
+*   @param buffer          [in]  - встроенный буфер (не меньше buffer_capacity * el_size байт)
+*   @param buffer_capacity [in]  - емкость встроенного буфера
+*   @param el_poison       [in]  - указатель на POISON-элемент стека
+*   @param el_dtor         [in]  - указатель на dtor элемента стека
+*   @param el_dump         [in]  - указатель на dump элемента стека
+*   @param alc             [in]  - аллокатор динамической памяти при переполнении буфера (nullptr - LOG_CALLOC)
+*
+*   @return true, если удалось создать стек, false - иначе.
+*
+*   @see small_stack
+*/
+bool stack_ctor_inline(stack *const stk, const size_t el_size, void *const buffer, const size_t buffer_capacity,
+                                                                     const void *const el_poison                     = nullptr,
+                                                                     void (     *el_dtor  )(      void *const) = nullptr,
+                                                                     void (     *el_dump  )(const void *const) = nullptr,
+                                                                     allocator   *alc                              = nullptr);
+
+/**
+*   @brief Конструктор стека со встроенным буфером на N элементов типа T.
+*
+*   @see stack_ctor_inline()
+*/
+template <typename T, size_t N>
+inline bool small_stack_ctor(small_stack<T, N> *const stk, const void *const el_poison                     = nullptr,
+                                                                 void (     *el_dtor  )(      void *const) = nullptr,
+                                                                 void (     *el_dump  )(const void *const) = nullptr,
+                                                                 allocator   *alc                              = nullptr)
+{
+    static_assert(N > 0, "small_stack needs a non-empty buffer");
+
+    if (stk == nullptr) return false;
+    return stack_ctor_inline(&stk->base, sizeof(T), stk->buf, N, el_poison, el_dtor, el_dump, alc);
+}
 
 /**
 *   @brief Создает стек в динамической памяти.
@@ -61,6 +153,7 @@ bool stack_ctor(stack *const stk, const size_t el_size, const void *const el_poi
 *   @param el_dtor        [in] - указатель на dtor элемента стека
 *   @param el_dump        [in] - указатель на dump элемента стека
 *   @param stack_capacity [in] - начальная емкость стека
+*   @param alc            [in] - аллокатор массива с элементами (nullptr - LOG_CALLOC)
 *
 *   @return указатель на созданный стек или nullptr в случае ошибки.
 */
@@ -68,7 +161,8 @@ stack *stack_new(const size_t el_size, const void *const el_poison
                                              void (     *el_dtor  )(      void *const) = nullptr,
                                              void (     *el_dump  )(const void *const) = nullptr,
 
-                                             const size_t stack_capacity = DEFAULT_STACK_CAPACITY);
+                                             const size_t stack_capacity = DEFAULT_STACK_CAPACITY,
+                                             allocator   *alc            = nullptr);
 
 /**
 *   @brief Деструктор стека.
@@ -104,6 +198,82 @@ bool stack_push(stack *const stk, const void *const data);
 */
 bool stack_pop(stack *const stk, void *const data = nullptr);
 
+/**
+*   @brief Кладет n элементов в конец стека.
+*   Емкость увеличивается не больше одного раза, элементы копируются одним memcpy.
+*
+*   @param stk [in, out] - указатель на стек
+*   @param src [in]      - указатель на массив из n элементов (может указывать внутрь самого стека)
+*   @param n   [in]      - количество элементов
+*
+*   @return true, в случае успеха, false в случае ошибки.
+*/
+bool stack_push_n(stack *const stk, const void *const src, const size_t n);
+
+/**
+*   @brief Удаляет n последних элементов стека.
+*
+*   @param stk [in, out] - указатель на стек
+*   @param n   [in]      - количество элементов
+*   @param dst [out]     - указатель, куда скопировать удаляемые элементы в порядке их расположения в стеке,
+*                          то есть последним окажется бывшая вершина (nullptr по умолчанию)
+*
+*   @return true, в случае успеха, false в случае ошибки.
+*/
+bool stack_pop_n(stack *const stk, const size_t n, void *const dst = nullptr);
+
+/**
+*   @brief Устанавливает политику изменения емкости стека.
+*   Новая политика применяется со следующего переполнения или удаления элемента, текущая емкость не меняется.
+*
+*   @param stk    [in, out] - указатель на стек
+*   @param growth [in]      - политика (копируется в стек)
+*
+*   @return true в случае успеха, false если политика некорректна.
+*
+*   @see struct stack_growth
+*/
+bool stack_set_growth(stack *const stk, const stack_growth *const growth);
+
+/**
+*   @brief Проверяет политику изменения емкости: рост должен строго увеличивать емкость, а уменьшение - давать гистерезис.
+*
+*   @see struct stack_growth
+*/
+bool stack_growth_is_valid(const stack_growth *const growth);
+
+/**
+*   @brief Емкость, до которой по политике growth растет контейнер емкости capacity, чтобы вместить min_capacity элементов.
+*   Политика применяется несколько раз, если одного шага не хватает. При переполнении size_t возвращается min_capacity.
+*/
+size_t stack_growth_grow(const stack_growth *const growth, const size_t capacity, const size_t min_capacity);
+
+/**
+*   @brief Емкость, до которой по политике growth уменьшается контейнер с size элементами и емкостью capacity
+*   (не ниже min_capacity), или capacity, если уменьшать не нужно.
+*/
+size_t stack_growth_shrink(const stack_growth *const growth, const size_t size, const size_t capacity, const size_t min_capacity);
+
+/**
+*   @brief Гарантирует емкость стека не меньше capacity.
+*   Кроме того, при удалении элементов стек больше не уменьшается автоматически ниже этой емкости.
+*
+*   @param stk      [in, out] - указатель на стек
+*   @param capacity [in]      - требуемая емкость
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool stack_reserve(stack *const stk, const size_t capacity);
+
+/**
+*   @brief Уменьшает емкость стека до его размера (но не меньше 1) и снимает ограничение, установленное stack_reserve().
+*
+*   @param stk [in, out] - указатель на стек
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+bool stack_shrink_to_fit(stack *const stk);
+
 /**
 *   @brief Показывает содержимое вершины стека.
 *
@@ -0,0 +1,626 @@
+/** @file */
+#ifndef TYPED_VECTOR_H
+#define TYPED_VECTOR_H
+
+#include <new>
+#include <utility>
+#include <stddef.h>
+#include <string.h>
+#include <type_traits>
+
+#include "log.h"
+#include "stack.h"
+#include "vector.h"
+
+//================================================================================================================================
+
+/**
+*   @brief Типизированный вектор с размером элемента, известным во время компиляции.
+*
+*   Для тривиально копируемых T это оболочка над стеком (поле base, el_size = sizeof(T)): политика роста, POISON-элемент
+*   и верификация те же, что у vector, а доступ к элементам и push/pop без изменения емкости встраиваются в место вызова
+*   без умножения на el_size и без memcpy переменной длины. Изменение емкости выполняют функции стека.
+*
+*   Для остальных T элементы хранятся в собственном массиве, при изменении емкости перемещаются (move),
+*   а сама емкость меняется по той же политике stack_growth. Массив выделяется тем же аллокатором, что и у стека,
+*   а свободные ячейки [size, capacity) так же заполняются байтами POISON-элемента и проверяются верификатором.
+*/
+template <typename T, bool is_trivial = std::is_trivially_copyable_v<T>>
+struct typed_vector;
+
+/**
+*   @brief Типизированный вектор тривиально копируемых элементов.
+*/
+template <typename T>
+struct typed_vector<T, true>
+{
+    stack base;                 ///< стек с элементами типа T
+};
+
+/**
+*   @brief Типизированный вектор элементов с нетривиальным копированием.
+*/
+template <typename T>
+struct typed_vector<T, false>
+{
+    T     *data;                ///< указатель на начало массива элементов
+
+    size_t size;                ///< количество элементов
+    size_t capacity;            ///< емкость
+
+    size_t       min_capacity;  ///< емкость, ниже которой вектор не уменьшается автоматически
+    stack_growth growth;        ///< политика изменения емкости
+
+    allocator *alc;             ///< аллокатор массива с элементами (nullptr - LOG_CALLOC)
+    const T   *el_poison;       ///< POISON-элемент, байтами которого заполнены свободные ячейки (nullptr - не заполняются)
+};
+
+//================================================================================================================================
+
+static const size_t TYPED_VECTOR_GAP_SAMPLES = 16; ///< количество проверяемых ячеек промежутка [size, capacity) в сборке без _DEBUG
+
+//================================================================================================================================
+
+#ifndef STACK_NVERIFY
+
+#define TYPED_VECTOR_VERIFY(vec, ret_val)           \
+    if (typed_vector_verify(vec) != 0)              \
+    {                                               \
+        return ret_val;                             \
+    }
+
+#define TYPED_VECTOR_CHECK(condition, ret_val)                              \
+    if (!(condition))                                                       \
+    {                                                                       \
+        LOG_ERROR("typed_vector verification failed: %s\n", #condition);    \
+        return ret_val;                                                     \
+    }
+
+#else
+
+#define TYPED_VECTOR_VERIFY(vec      , ret_val)
+#define TYPED_VECTOR_CHECK(condition, ret_val)
+
+#endif
+
+//================================================================================================================================
+// TRIVIALLY COPYABLE
+//================================================================================================================================
+
+/**
+*   @brief Верификатор вектора.
+*   @return 0, если вектор валидный.
+*
+*   @see stack_verify(const stack *)
+*/
+template <typename T>
+inline unsigned typed_vector_verify(const typed_vector<T, true> *const vec)
+{
+    if (vec == nullptr)
+    {
+        LOG_ERROR("typed_vector is nullptr\n");
+        return 1;
+    }
+
+    const unsigned err = stack_verify(&vec->base);
+    if (err == 0 && vec->base.el_size != sizeof(T))
+    {
+        LOG_ERROR("typed_vector.base.el_size = %lu, expected sizeof(T) = %lu\n", vec->base.el_size, sizeof(T));
+        return 1;
+    }
+
+    return err;
+}
+
+/**
+*   @brief Конструктор вектора.
+*
+*   @param vec       [out] - указатель на вектор
+*   @param el_poison [in]  - указатель на POISON-элемент
+*   @param el_dump   [in]  - указатель на dump элемента
+*   @param capacity  [in]  - начальная емкость
+*   @param alc       [in]  - аллокатор массива с элементами (nullptr - LOG_CALLOC)
+*
+*   @return true, если удалось создать вектор, false - иначе.
+*/
+template <typename T>
+inline bool typed_vector_ctor(typed_vector<T, true> *const vec, const T *const el_poison                  = nullptr,
+                                                                void   (     *el_dump)(const void *const) = nullptr,
+                                                                const size_t capacity = DEFAULT_STACK_CAPACITY,
+                                                                allocator   *alc      = nullptr)
+{
+    TYPED_VECTOR_CHECK(vec != nullptr, false);
+    return stack_ctor(&vec->base, sizeof(T), el_poison, nullptr, el_dump, capacity, alc);
+}
+
+/**
+*   @brief Деструктор вектора.
+*/
+template <typename T>
+inline void typed_vector_dtor(typed_vector<T, true> *const vec)
+{
+    if (vec == nullptr) return;
+    stack_dtor(&vec->base);
+}
+
+/**
+*   @brief Кладет элемент в конец вектора.
+*   Если емкости хватает, элемент записывается на месте вызова, иначе вызывается stack_push().
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+template <typename T>
+inline bool typed_vector_push_back(typed_vector<T, true> *const vec, const T &value)
+{
+    TYPED_VECTOR_VERIFY(vec, false);
+
+    stack *const base = &vec->base;
+
+    if (base->size == base->capacity)
+    {
+        const T copy = value; // value может лежать в самом векторе, а stack_push() перевыделяет память до копирования
+        return stack_push(base, &copy);
+    }
+
+    ((T *) base->data)[base->size++] = value;
+    return true;
+}
+
+/**
+*   @brief Удаляет последний элемент вектора.
+*   Если после удаления емкость может уменьшиться, вызывается stack_pop(), иначе элемент удаляется на месте вызова.
+*
+*   @param vec [in, out] - указатель на вектор
+*   @param out [out]     - указатель, куда скопировать удаляемый элемент (nullptr по умолчанию)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+template <typename T>
+inline bool typed_vector_pop_back(typed_vector<T, true> *const vec, T *const out = nullptr)
+{
+    TYPED_VECTOR_VERIFY(vec, false);
+
+    stack *const base = &vec->base;
+    TYPED_VECTOR_CHECK(base->size != 0, false);
+
+    const stack_growth *const growth = &base->growth;
+
+    if (growth->shrink_ratio != 0 && base->capacity > base->min_capacity &&
+        base->size - 1 <= base->capacity / growth->shrink_ratio) return stack_pop(base, out);
+
+    T *const el = (T *) base->data + --base->size;
+
+    if (out            != nullptr) *out = *el;
+    if (base->el_poison != nullptr) memcpy(el, base->el_poison, sizeof(T));
+
+    return true;
+}
+
+/**
+*   @brief Возвращает указатель на элемент вектора или nullptr, если index за границами (в сборке с верификацией).
+*/
+template <typename T>
+inline T *typed_vector_get(const typed_vector<T, true> *const vec, const size_t index)
+{
+    TYPED_VECTOR_VERIFY(vec, nullptr);
+    TYPED_VECTOR_CHECK (index < vec->base.size, nullptr);
+
+    return (T *) vec->base.data + index;
+}
+
+/**
+*   @brief Возвращает указатель на первый элемент вектора.
+*/
+template <typename T>
+inline T *typed_vector_begin(const typed_vector<T, true> *const vec)
+{
+    TYPED_VECTOR_VERIFY(vec, nullptr);
+    return (T *) vec->base.data;
+}
+
+/**
+*   @brief Возвращает указатель на элемент, следующий за последним.
+*/
+template <typename T>
+inline T *typed_vector_end(const typed_vector<T, true> *const vec)
+{
+    TYPED_VECTOR_VERIFY(vec, nullptr);
+    return (T *) vec->base.data + vec->base.size;
+}
+
+/**
+*   @brief Возвращает количество элементов вектора.
+*/
+template <typename T>
+inline size_t typed_vector_size(const typed_vector<T, true> *const vec)
+{
+    TYPED_VECTOR_VERIFY(vec, 0);
+    return vec->base.size;
+}
+
+/**
+*   @brief Гарантирует емкость вектора не меньше capacity.
+*
+*   @see stack_reserve(stack *, size_t)
+*/
+template <typename T>
+inline bool typed_vector_reserve(typed_vector<T, true> *const vec, const size_t capacity)
+{
+    TYPED_VECTOR_CHECK(vec != nullptr, false);
+    return stack_reserve(&vec->base, capacity);
+}
+
+/**
+*   @brief Устанавливает политику изменения емкости вектора.
+*
+*   @see stack_set_growth(stack *, const stack_growth *)
+*/
+template <typename T>
+inline bool typed_vector_set_growth(typed_vector<T, true> *const vec, const stack_growth *const growth)
+{
+    TYPED_VECTOR_CHECK(vec != nullptr, false);
+    return stack_set_growth(&vec->base, growth);
+}
+
+/**
+*   @brief Возвращает нетипизированный вектор с теми же элементами, например, для vector_sort().
+*/
+template <typename T>
+inline vector *typed_vector_as_vector(typed_vector<T, true> *const vec)
+{
+    TYPED_VECTOR_CHECK(vec != nullptr, nullptr);
+    return &vec->base;
+}
+
+/**
+*   @brief Дамп вектора.
+*/
+template <typename T>
+inline void typed_vector_dump(const typed_vector<T, true> *const vec)
+{
+    if (vec == nullptr) return;
+    stack_dump(&vec->base);
+}
+
+//================================================================================================================================
+// NON-TRIVIALLY COPYABLE
+//================================================================================================================================
+
+/**
+*   @brief Проверяет, что свободные ячейки [size, capacity) совпадают побайтово с POISON-элементом.
+*   Отладочная сборка проверяет весь промежуток, сборка без _DEBUG - не больше TYPED_VECTOR_GAP_SAMPLES ячеек.
+*
+*   @see stack_verify(const stack *)
+*/
+template <typename T>
+inline bool typed_vector_gap_is_poison(const typed_vector<T, false> *const vec)
+{
+    if (vec->el_poison == nullptr) return true;
+
+#ifdef STACK_NVERIFY
+    return true;
+#else
+    const size_t gap = vec->capacity - vec->size;
+
+#ifndef STACK_NDEBUG
+    const size_t samples = gap;
+#else
+    const size_t samples = (gap < TYPED_VECTOR_GAP_SAMPLES) ? gap : TYPED_VECTOR_GAP_SAMPLES;
+#endif
+
+    for (size_t sample = 0; sample < samples; ++sample)
+    {
+        size_t check_index = (samples == gap) ? vec->size + sample
+                                              : vec->size + sample * (gap - 1) / (samples - 1);
+
+        if (memcmp((const void *) (vec->data + check_index), (const void *) vec->el_poison, sizeof(T)) != 0)
+            return false;
+    }
+
+    return true;
+#endif
+}
+
+/**
+*   @brief Заполняет ячейки [from, to) байтами POISON-элемента. Объектов в этих ячейках быть не должно.
+*/
+template <typename T>
+inline void typed_vector_range_fill_poison(typed_vector<T, false> *const vec, const size_t from, const size_t to)
+{
+    if (vec->el_poison == nullptr) return;
+
+    for (size_t i = from; i < to; ++i) memcpy((void *) (vec->data + i), (const void *) vec->el_poison, sizeof(T));
+}
+
+/**
+*   @brief Заполняет POISON-элементом новые ячейки [from, capacity).
+*   Как и у стека, без верификации (STACK_NVERIFY) новые ячейки не заполняются.
+*/
+template <typename T>
+inline void typed_vector_gap_fill_poison(typed_vector<T, false> *const vec, const size_t from)
+{
+#ifndef STACK_NVERIFY
+    typed_vector_range_fill_poison(vec, from, vec->capacity);
+#else
+    (void) vec;
+    (void) from;
+#endif
+}
+
+/**
+*   @brief Верификатор вектора.
+*   @return 0, если вектор валидный.
+*/
+template <typename T>
+inline unsigned typed_vector_verify(const typed_vector<T, false> *const vec)
+{
+    unsigned err = 0;
+
+    if (vec == nullptr)
+    {
+        LOG_ERROR("typed_vector is nullptr\n");
+        return 1;
+    }
+
+    if (vec->data == nullptr)                       { LOG_ERROR("typed_vector.data is nullptr\n");                  err = 1; }
+    if (vec->size > vec->capacity)                  { LOG_ERROR("typed_vector.size more than typed_vector.capacity\n"); err = 1; }
+    if (vec->min_capacity == 0)                     { LOG_ERROR("typed_vector.min_capacity is zero\n");             err = 1; }
+    if (!stack_growth_is_valid(&vec->growth))       { LOG_ERROR("typed_vector.growth is inconsistent\n");           err = 1; }
+
+    if (err == 0 && !typed_vector_gap_is_poison(vec)) { LOG_ERROR("typed_vector gap [size, capacity) is not POISON\n"); err = 1; }
+
+    return err;
+}
+
+/**
+*   @brief Переносит элементы вектора в новый массив емкости new_capacity (new_capacity >= size).
+*   Элементы перемещаются move-конструктором, старые объекты разрушаются.
+*/
+template <typename T>
+inline void typed_vector_move_to(typed_vector<T, false> *const vec, T *const new_data, const size_t new_capacity)
+{
+    LOG_ASSERT(new_data != nullptr);
+    LOG_ASSERT(new_capacity >= vec->size);
+
+    for (size_t i = 0; i < vec->size; ++i)
+    {
+        new (new_data + i) T(std::move(vec->data[i]));
+        vec->data[i].~T();
+    }
+
+    allocator_free(vec->alc, vec->data, vec->capacity * sizeof(T));
+
+    vec->data     = new_data;
+    vec->capacity = new_capacity;
+}
+
+/**
+*   @brief Выделяет массив под capacity элементов аллокатором alc.
+*/
+template <typename T>
+inline T *typed_vector_alloc(allocator *const alc, const size_t capacity)
+{
+    static_assert(alignof(T) <= alignof(max_align_t), "typed_vector doesn't support over-aligned types");
+
+    T *data = (T *) allocator_calloc(alc, capacity, sizeof(T));
+    if (data == nullptr)
+    {
+        LOG_ERROR("allocator_calloc(capacity = %lu, sizeof(T) = %lu) returns nullptr\n", capacity, sizeof(T));
+    }
+
+    return data;
+}
+
+/**
+*   @brief Конструктор вектора.
+*
+*   @param vec       [out] - указатель на вектор
+*   @param el_poison [in]  - POISON-элемент, байтами которого заполняются свободные ячейки (nullptr - не заполнять)
+*   @param capacity  [in]  - начальная емкость
+*   @param alc       [in]  - аллокатор массива с элементами (nullptr - LOG_CALLOC)
+*
+*   @return true, если удалось создать вектор, false - иначе.
+*/
+template <typename T>
+inline bool typed_vector_ctor(typed_vector<T, false> *const vec, const T *const el_poison = nullptr,
+                                                                 const size_t   capacity  = DEFAULT_STACK_CAPACITY,
+                                                                 allocator     *alc       = nullptr)
+{
+    TYPED_VECTOR_CHECK(vec != nullptr, false);
+    TYPED_VECTOR_CHECK(capacity > 0  , false);
+
+    vec->data = typed_vector_alloc<T>(alc, capacity);
+    if (vec->data == nullptr) return false;
+
+    vec->size         = 0;
+    vec->capacity     = capacity;
+    vec->min_capacity = DEFAULT_STACK_CAPACITY;
+    vec->growth       = DEFAULT_STACK_GROWTH;
+    vec->alc          = alc;
+    vec->el_poison    = el_poison;
+
+    typed_vector_gap_fill_poison(vec, 0);
+    return true;
+}
+
+/**
+*   @brief Деструктор вектора. Разрушает все элементы.
+*/
+template <typename T>
+inline void typed_vector_dtor(typed_vector<T, false> *const vec)
+{
+    if (vec == nullptr) return;
+    TYPED_VECTOR_VERIFY(vec, (void) 0);
+
+    for (size_t i = 0; i < vec->size; ++i) vec->data[i].~T();
+    allocator_free(vec->alc, vec->data, vec->capacity * sizeof(T));
+
+    vec->data     = nullptr;
+    vec->size     = 0;
+    vec->capacity = 0;
+}
+
+/**
+*   @brief Создает элемент в конце вектора из аргументов args.
+*   При нехватке емкости новый элемент создается в новом массиве раньше, чем туда переносятся старые,
+*   поэтому args могут ссылаться на элементы самого вектора.
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+template <typename T, typename... Args>
+inline bool typed_vector_emplace_back(typed_vector<T, false> *const vec, Args &&...args)
+{
+    TYPED_VECTOR_VERIFY(vec, false);
+
+    if (vec->size < vec->capacity)
+    {
+        new (vec->data + vec->size) T(std::forward<Args>(args)...);
+        vec->size++;
+        return true;
+    }
+
+    const size_t new_capacity = stack_growth_grow(&vec->growth, vec->capacity, vec->size + 1);
+
+    T *const new_data = typed_vector_alloc<T>(vec->alc, new_capacity);
+    if (new_data == nullptr) return false;
+
+    new (new_data + vec->size) T(std::forward<Args>(args)...);
+    typed_vector_move_to(vec, new_data, new_capacity);
+    vec->size++;
+
+    typed_vector_gap_fill_poison(vec, vec->size);
+    return true;
+}
+
+/**
+*   @brief Кладет копию элемента в конец вектора.
+*/
+template <typename T>
+inline bool typed_vector_push_back(typed_vector<T, false> *const vec, const T &value)
+{
+    return typed_vector_emplace_back(vec, value);
+}
+
+/**
+*   @brief Перемещает элемент в конец вектора.
+*/
+template <typename T>
+inline bool typed_vector_push_back(typed_vector<T, false> *const vec, T &&value)
+{
+    return typed_vector_emplace_back(vec, std::move(value));
+}
+
+/**
+*   @brief Удаляет последний элемент вектора и, если нужно, уменьшает емкость по политике вектора.
+*
+*   @param vec [in, out] - указатель на вектор
+*   @param out [out]     - указатель, куда переместить удаляемый элемент (nullptr по умолчанию)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*/
+template <typename T>
+inline bool typed_vector_pop_back(typed_vector<T, false> *const vec, T *const out = nullptr)
+{
+    TYPED_VECTOR_VERIFY(vec, false);
+    TYPED_VECTOR_CHECK (vec->size != 0, false);
+
+    T *const el = vec->data + vec->size - 1;
+
+    if (out != nullptr) *out = std::move(*el);
+    el->~T();
+    vec->size--;
+
+    typed_vector_range_fill_poison(vec, vec->size, vec->size + 1);
+
+    const size_t new_capacity = stack_growth_shrink(&vec->growth, vec->size, vec->capacity, vec->min_capacity);
+    if (new_capacity != vec->capacity)
+    {
+        T *const new_data = typed_vector_alloc<T>(vec->alc, new_capacity);
+        if (new_data == nullptr) return true;
+
+        typed_vector_move_to(vec, new_data, new_capacity);
+        typed_vector_gap_fill_poison(vec, vec->size);
+    }
+
+    return true;
+}
+
+/**
+*   @brief Возвращает указатель на элемент вектора или nullptr, если index за границами (в сборке с верификацией).
+*/
+template <typename T>
+inline T *typed_vector_get(const typed_vector<T, false> *const vec, const size_t index)
+{
+    TYPED_VECTOR_VERIFY(vec, nullptr);
+    TYPED_VECTOR_CHECK (index < vec->size, nullptr);
+
+    return vec->data + index;
+}
+
+/**
+*   @brief Возвращает указатель на первый элемент вектора.
+*/
+template <typename T>
+inline T *typed_vector_begin(const typed_vector<T, false> *const vec)
+{
+    TYPED_VECTOR_VERIFY(vec, nullptr);
+    return vec->data;
+}
+
+/**
+*   @brief Возвращает указатель на элемент, следующий за последним.
+*/
+template <typename T>
+inline T *typed_vector_end(const typed_vector<T, false> *const vec)
+{
+    TYPED_VECTOR_VERIFY(vec, nullptr);
+    return vec->data + vec->size;
+}
+
+/**
+*   @brief Возвращает количество элементов вектора.
+*/
+template <typename T>
+inline size_t typed_vector_size(const typed_vector<T, false> *const vec)
+{
+    TYPED_VECTOR_VERIFY(vec, 0);
+    return vec->size;
+}
+
+/**
+*   @brief Гарантирует емкость вектора не меньше capacity.
+*   Кроме того, при удалении элементов вектор больше не уменьшается автоматически ниже этой емкости.
+*/
+template <typename T>
+inline bool typed_vector_reserve(typed_vector<T, false> *const vec, const size_t capacity)
+{
+    TYPED_VECTOR_VERIFY(vec, false);
+
+    if (capacity > vec->min_capacity) vec->min_capacity = capacity;
+    if (capacity <= vec->capacity) return true;
+
+    T *const new_data = typed_vector_alloc<T>(vec->alc, capacity);
+    if (new_data == nullptr) return false;
+
+    typed_vector_move_to(vec, new_data, capacity);
+    typed_vector_gap_fill_poison(vec, vec->size);
+
+    return true;
+}
+
+/**
+*   @brief Устанавливает политику изменения емкости вектора.
+*
+*   @return true в случае успеха, false если политика некорректна.
+*/
+template <typename T>
+inline bool typed_vector_set_growth(typed_vector<T, false> *const vec, const stack_growth *const growth)
+{
+    TYPED_VECTOR_VERIFY(vec, false);
+    TYPED_VECTOR_CHECK (growth != nullptr && stack_growth_is_valid(growth), false);
+
+    vec->growth = *growth;
+    return true;
+}
+
+#endif // TYPED_VECTOR_H
@@ -59,6 +59,7 @@ typedef stack vector;
 *   @param el_dtor         [in]  - указатель на dtor элемента вектора
 *   @param el_dump         [in]  - указатель на dump элемента вектора
 *   @param vector_capacity [in]  - начальная емкость вектора
+*   @param alc             [in]  - аллокатор массива с элементами (nullptr - LOG_CALLOC)
 *
 *   @return true, если удалось создать вектор, false - иначе.
 */
@@ -66,9 +67,10 @@ inline bool vector_ctor(vector *const vec, const size_t el_size, const void *con
                                                                        void (     *el_dtor  )(      void *const) = nullptr,
                                                                        void (     *el_dump  )(const void *const) = nullptr,
 
-                                                                 const size_t vector_capacity = DEFAULT_STACK_CAPACITY)
+                                                                 const size_t vector_capacity = DEFAULT_STACK_CAPACITY,
+                                                                 allocator   *alc             = nullptr)
 {
-    return stack_ctor(vec, el_size, el_poison, el_dtor, el_dump, vector_capacity);
+    return stack_ctor(vec, el_size, el_poison, el_dtor, el_dump, vector_capacity, alc);
 }
 
 /**
@@ -79,6 +81,7 @@ inline bool vector_ctor(vector *const vec, const size_t el_size, const void *con
 *   @param el_dtor         [in] - указатель на dtor элемента вектора
 *   @param el_dump         [in] - указатель на dump элемента вектора
 *   @param vector_capacity [in] - начальная емкость вектора
+*   @param alc             [in] - аллокатор массива с элементами (nullptr - LOG_CALLOC)
 *
 *   @return указатель на созданный вектор или nullptr в случае ошибки.
 */
@@ -86,9 +89,10 @@ inline vector *vector_new(const size_t el_size, const void *const el_poison
                                                       void (     *el_dtor  )(      void *const) = nullptr,
                                                       void (     *el_dump  )(const void *const) = nullptr,
 
-                                                const size_t vector_capacity = DEFAULT_STACK_CAPACITY)
+                                                const size_t vector_capacity = DEFAULT_STACK_CAPACITY,
+                                                allocator   *alc             = nullptr)
 {
-    return stack_new(el_size, el_poison, el_dtor, el_dump, vector_capacity);
+    return stack_new(el_size, el_poison, el_dtor, el_dump, vector_capacity, alc);
 }
 
 /**
@@ -139,6 +143,56 @@ inline bool vector_pop_back(vector *const vec, void *const data = nullptr)
     return stack_pop(vec, data);
 }
 
+/**
+*   @brief Кладет n элементов в конец вектора.
+*
+*   @see stack_push_n(stack *, const void *, size_t)
+*/
+inline bool vector_push_back_n(vector *const vec, const void *const src, const size_t n)
+{
+    return stack_push_n(vec, src, n);
+}
+
+/**
+*   @brief Удаляет n последних элементов вектора.
+*
+*   @see stack_pop_n(stack *, size_t, void *)
+*/
+inline bool vector_pop_back_n(vector *const vec, const size_t n, void *const dst = nullptr)
+{
+    return stack_pop_n(vec, n, dst);
+}
+
+/**
+*   @brief Устанавливает политику изменения емкости вектора.
+*
+*   @see stack_set_growth(stack *, const stack_growth *)
+*/
+inline bool vector_set_growth(vector *const vec, const stack_growth *const growth)
+{
+    return stack_set_growth(vec, growth);
+}
+
+/**
+*   @brief Гарантирует емкость вектора не меньше capacity.
+*
+*   @see stack_reserve(stack *, size_t)
+*/
+inline bool vector_reserve(vector *const vec, const size_t capacity)
+{
+    return stack_reserve(vec, capacity);
+}
+
+/**
+*   @brief Уменьшает емкость вектора до его размера.
+*
+*   @see stack_shrink_to_fit(stack *)
+*/
+inline bool vector_shrink_to_fit(vector *const vec)
+{
+    return stack_shrink_to_fit(vec);
+}
+
 /**
 *   @brief Возвращает указатель на элемент вектора.
 *
@@ -175,6 +229,7 @@ bool vector_set(vector *const vec, const size_t index, const void *const data);
 *   Если новый размер равен старому, ничего не происходит.
 *   Если новый размер больше старого, инициализирует новую память нулями.
 *   Если новый размер меньше старого, отбрасываются последние элементы.
+*   Емкость меняется по политике вектора (см. vector_set_growth()).
 *
 *   @param vec   [in] - указатель на вектор
 *   @param count [in] - новый размер вектора
@@ -184,6 +239,41 @@ bool vector_set(vector *const vec, const size_t index, const void *const data);
 */
 bool vector_resize(vector *const vec, const size_t count);
 
+/**
+*   @brief Дописывает в конец вектора все элементы другого вектора (побайтово, как vector_push_back()).
+*
+*   @param vec   [in, out] - указатель на вектор
+*   @param other [in]      - указатель на дописываемый вектор (может совпадать с vec)
+*
+*   @return true в случае успеха, false в случае ошибки (в том числе если размеры элементов векторов различаются).
+*/
+bool vector_append(vector *const vec, const vector *const other);
+
+/**
+*   @brief Сортирует элементы вектора.
+*
+*   @param vec    [in, out] - указатель на вектор
+*   @param el_cmp [in]      - указатель на функцию сравнения элементов (аналогично qsort)
+*
+*   @return true в случае успеха, false в случае ошибки
+*
+*   @see my_sort(void *, size_t, size_t, int (*)(const void *, const void *))
+*/
+bool vector_sort(vector *const vec, int (*el_cmp)(const void *el_1, const void *el_2));
+
+/**
+*   @brief Сортирует элементы вектора в несколько потоков.
+*
+*   @param vec          [in, out] - указатель на вектор
+*   @param el_cmp       [in]      - указатель на функцию сравнения элементов (аналогично qsort)
+*   @param thread_count [in]      - количество потоков (0 - по количеству доступных процессоров)
+*
+*   @return true в случае успеха, false в случае ошибки.
+*
+*   @see my_parallel_sort(void *, size_t, size_t, int (*)(const void *, const void *), size_t)
+*/
+bool vector_parallel_sort(vector *const vec, int (*el_cmp)(const void *el_1, const void *el_2), const size_t thread_count = 0);
+
 /**
 *   @brief Проверяет, пустой ли вектор.
 *
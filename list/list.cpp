@@ -16,6 +16,7 @@ $o      return err;
 
 $   err = list_fields_verify(lst);
 $   if (err == LST_OK) err = list_cycle_verify(lst);
+$   if (err == LST_OK) err = list_index_verify(lst);
 
 $   list_log_error(lst, err);
 $o  return err;
@@ -59,10 +60,12 @@ $i
     poison_verify(el_size  , LST_POISON_EL_SIZE  )
     poison_verify(el_dtor  , LST_POISON_EL_DTOR  )
     poison_verify(el_dump  , LST_POISON_EL_DUMP  )
+    poison_verify(index    , LST_POISON_INDEX    )
 
     #undef poison_verify
 
     if (lst->fictional == nullptr) err |= (1 << LST_NULLPTR_FICTIONAL);
+    if (lst->alc       == nullptr) err |= (1 << LST_NULLPTR_ALC);
 
 $o  return err;
 }
@@ -117,209 +120,1203 @@ $o  return LST_OK;
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
+static unsigned list_index_verify(const list *const lst)
+{
+$i
+    LOG_ASSERT(lst            != nullptr);
+    LOG_ASSERT(lst->fictional != nullptr);
+
+    if (lst->index == nullptr) { $o return LST_OK; }
+
+    if (list_index_size(lst->index->root) != lst->size) { $o return 1 << LST_INVALID_INDEX; }
+
+    const list_node *lst_node = lst->fictional->next;
+$   if (!list_index_order_verify(lst->index->root, &lst_node)) { $o return 1 << LST_INVALID_INDEX; }
+
+$o  return LST_OK;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static bool list_index_order_verify(const list_index_node *const idx_node, const list_node **const lst_node)
+{
+    LOG_ASSERT(lst_node != nullptr);
+
+    if (idx_node == nullptr) return true;
+
+    if (idx_node->size != list_index_size(idx_node->left) + list_index_size(idx_node->right) + 1) return false;
+    if (idx_node->left  != nullptr && idx_node->left ->prio > idx_node->prio)                     return false;
+    if (idx_node->right != nullptr && idx_node->right->prio > idx_node->prio)                     return false;
+
+    if (!list_index_order_verify(idx_node->left, lst_node)) return false;
+    if (idx_node->node != *lst_node)                        return false;
+
+    *lst_node = (*lst_node)->next;
+    return list_index_order_verify(idx_node->right, lst_node);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
 bool list_ctor(list *const lst, const size_t el_size, void (*el_dtor) (      void *const) /* = nullptr */,
-                                                      void (*el_dump) (const void *const) /* = nullptr */)
+                                                      void (*el_dump) (const void *const) /* = nullptr */,
+                                                      allocator *alc                      /* = nullptr */)
+{
+$i
+    LOG_VERIFY(lst != nullptr, false);
+    LOG_VERIFY(el_size > 0UL , false);
+
+    lst->size    = 0;
+    lst->el_size = el_size;
+    lst->el_dtor = el_dtor;
+    lst->el_dump = el_dump;
+
+    lst->alc      = alc;
+    lst->own_slab = nullptr;
+    lst->index    = nullptr;
+
+$   if (alc == nullptr && !list_own_slab_ctor(lst)) { $o return false; }
+$   if (!list_fictional_ctor(lst))
+    {
+$       list_own_slab_dtor(lst);
+$o      return false;
+    }
+
+$   LIST_ASSERT(lst);
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+list *list_new(const size_t el_size, void (*el_dtor) (      void *const) /* = nullptr */,
+                                     void (*el_dump) (const void *const) /* = nullptr */,
+                                     allocator *alc                      /* = nullptr */)
+{
+$i
+$   list *lst = (list *) LOG_CALLOC(1, sizeof(list));
+    if (lst == nullptr)
+    {
+$       LOG_ERROR("log_calloc(1, sizeof(list) = %lu) returns nullptr\n", sizeof(list));
+$o      return nullptr;
+    }
+$   if (!list_ctor(lst, el_size, el_dtor, el_dump, alc))
+    {
+        LOG_FREE(lst);
+$o      return nullptr;
+    }
+
+$   LIST_ASSERT(lst);
+$o  return lst;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static bool list_own_slab_ctor(list *const lst)
+{
+$i
+    LOG_ASSERT(lst != nullptr);
+
+$   list_slab *ls = (list_slab *) LOG_CALLOC(1, sizeof(list_slab));
+    if (ls == nullptr)
+    {
+$       LOG_ERROR("log_calloc(1, sizeof(list_slab) = %lu) returns nullptr\n", sizeof(list_slab));
+$o      return false;
+    }
+
+$   if (!slab_ctor(&ls->nodes, list_node_size(lst->el_size)))
+    {
+$       LOG_FREE(ls);
+$o      return false;
+    }
+
+    ls->base.alloc_fn   = list_slab_alloc;
+    ls->base.realloc_fn = list_slab_realloc;
+    ls->base.free_fn    = list_slab_free;
+
+    ls->parent = nullptr;
+    ls->refs   = 1;
+    ls->lists  = 1;
+
+    lst->own_slab = ls;
+    lst->alc      = &ls->base;
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void list_own_slab_dtor(list *const lst)
+{
+$i
+    LOG_ASSERT(lst != nullptr);
+
+    if (lst->own_slab == nullptr) { $o return; }
+
+$   list_slab_root   (lst->own_slab)->lists--;
+$   list_slab_release(lst->own_slab);
+
+    lst->own_slab = nullptr;
+    lst->alc      = nullptr;
+$o
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief true, если собственный slab листа ни с кем не объединен, то есть все его вершины принадлежат этому листу.
+*/
+static bool list_is_exclusive_slab(const list *const lst)
+{
+    LOG_ASSERT(lst != nullptr);
+
+    return lst->own_slab != nullptr && lst->own_slab->parent == nullptr && lst->own_slab->refs == 1;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Проверяет, можно ли перевешивать вершины src в dst без копирования.
+*   Это так, если у листов общий аллокатор или оба листа используют собственные slab-ы: тогда slab-ы объединяются в одну группу.
+*/
+static bool list_is_relinkable(list *const dst, list *const src)
+{
+$i
+    LOG_ASSERT(dst != nullptr);
+    LOG_ASSERT(src != nullptr);
+    LOG_ASSERT(dst->el_size == src->el_size);
+
+    if (dst->alc == src->alc)                                   { $o return true;  }
+    if (dst->own_slab == nullptr || src->own_slab == nullptr)   { $o return false; }
+
+$   list_slab_join(dst->own_slab, src->own_slab);
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Возвращает корень группы slab-а и сжимает путь: все slab-ы на пути перевешиваются прямо на корень.
+*   Ссылка каждого перевешенного slab-а переходит от старого родителя к корню. Промежуточный slab, на который
+*   после этого никто не ссылается, разрушается (он пустой: его память уже перенесена в корень).
+*/
+static list_slab *list_slab_root(list_slab *const ls)
+{
+    LOG_ASSERT(ls != nullptr);
+
+    list_slab *root = ls;
+    while (root->parent != nullptr) root = root->parent;
+
+    list_slab *cur = ls;
+    while (cur->parent != nullptr && cur->parent != root)
+    {
+        list_slab *const parent = cur->parent;
+
+        cur->parent = root;
+        root  ->refs++;
+        parent->refs--;
+
+        if (cur->refs == 0)
+        {
+            slab_dtor(&cur->nodes);
+            LOG_FREE (cur);
+            root->refs--;
+        }
+
+        cur = parent;
+    }
+
+    if (cur != root && cur->refs == 0)
+    {
+        slab_dtor(&cur->nodes);
+        LOG_FREE (cur);
+        root->refs--;
+    }
+
+    return root;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Объединяет группы двух slab-ов: группа с меньшим числом листов подвешивается к корню большей,
+*   и память ее корня переносится в корень большей группы.
+*/
+static void list_slab_join(list_slab *const ls_1, list_slab *const ls_2)
+{
+$i
+    list_slab *root_1 = list_slab_root(ls_1);
+    list_slab *root_2 = list_slab_root(ls_2);
+
+    if (root_1 == root_2) { $o return; }
+
+    if (root_1->lists < root_2->lists)
+    {
+        list_slab *const temp = root_1; root_1 = root_2; root_2 = temp;
+    }
+
+$   bool is_absorbed = slab_absorb(&root_1->nodes, &root_2->nodes);
+    LOG_ASSERT(is_absorbed);
+    (void) is_absorbed;
+
+    root_2->parent = root_1;
+    root_1->refs++;
+    root_1->lists += root_2->lists;
+$o
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Снимает одну ссылку со slab-а. slab без ссылок разрушается и снимает ссылку со своего родителя,
+*   так что память группы возвращается системе вместе с последним листом группы.
+*/
+static void list_slab_release(list_slab *ls)
+{
+$i
+    while (ls != nullptr && --ls->refs == 0)
+    {
+        list_slab *const parent = ls->parent;
+
+$       slab_dtor(&ls->nodes);
+$       LOG_FREE (ls);
+
+        ls = parent;
+    }
+$o
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void *list_slab_alloc(allocator *const alc, const size_t size)
+{
+    return allocator_calloc(&list_slab_root((list_slab *) alc)->nodes.base, 1, size);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void *list_slab_realloc(allocator *const alc, void *const ptr, const size_t old_size, const size_t new_size)
+{
+    return allocator_recalloc(&list_slab_root((list_slab *) alc)->nodes.base, ptr, old_size, new_size);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void list_slab_free(allocator *const alc, void *const ptr, const size_t size)
+{
+    allocator_free(&list_slab_root((list_slab *) alc)->nodes.base, ptr, size);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static bool list_fictional_ctor(list *const lst)
+{
+$i
+    LOG_ASSERT(lst != nullptr);
+
+$   lst->fictional = (list_node *) allocator_calloc(lst->alc, 1, sizeof(list_node));
+    if (lst->fictional == nullptr)
+    {
+$       LOG_ERROR("allocator_calloc(1, sizeof(list_node) = %lu) returns nullptr\n", sizeof(list_node));
+$o      return false;
+    }
+
+    lst->fictional->prev = lst->fictional;
+    lst->fictional->next = lst->fictional;
+
+$   LIST_ASSERT(lst);
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static bool list_node_new(list *const lst, const void      *const data,
+                                           const list_node *const prev,
+                                           const list_node *const next)
+{
+$i
+$   LIST_ASSERT(lst);
+    LOG_ASSERT (data != nullptr);
+    LOG_ASSERT (prev != nullptr);
+    LOG_ASSERT (next != nullptr);
+
+    list_node *lst_node = (list_node *) allocator_calloc(lst->alc, 1, list_node_size(lst->el_size));
+    if (lst_node == nullptr)
+    {
+$       LOG_ERROR("allocator_calloc(1, sizeof(list_node) = %lu + el_size = %lu) returns nullptr\n",
+                                 sizeof(list_node),   lst->el_size);
+$o      return false;
+    }
+$   list_node_ctor(lst, lst_node, data, prev, next);
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-qual"
+
+static void list_node_ctor(list      *const lst,
+                           list_node *const lst_node, const void      *const data,
+                                                      const list_node *const prev,
+                                                      const list_node *const next)
+{
+$i
+$   LIST_ASSERT(lst);
+    LOG_ASSERT (lst_node != nullptr);
+    LOG_ASSERT (data     != nullptr);
+    LOG_ASSERT (prev     != nullptr);
+    LOG_ASSERT (next     != nullptr);
+
+    lst_node->prev = (list_node *) prev; lst_node->prev->next = lst_node;
+    lst_node->next = (list_node *) next; lst_node->next->prev = lst_node;
+$   memcpy(lst_node + 1, data, lst->el_size);
+
+    lst->size++;
+$o
+}
+
+#pragma GCC diagnostic pop
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static bool list_node_delete(list      *const lst,
+                             list_node *const lst_node, const size_t pos, void *const erased_data)
+{
+$i
+$   LIST_ASSERT(lst);
+    LOG_ASSERT (lst_node != nullptr);
+    LOG_ASSERT (pos < lst->size);
+
+    void *erased_el = lst_node + 1;
+
+    if (erased_data  != nullptr) memcpy(erased_data, erased_el, lst->el_size);
+    if (lst->el_dtor != nullptr) { $ lst->el_dtor(erased_el); }
+
+$   list_node_unlink(lst, lst_node, pos);
+
+$   LIST_ASSERT(lst);
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void list_node_unlink(list *const lst, list_node *const lst_node, const size_t pos)
+{
+$i
+    LOG_ASSERT(lst      != nullptr);
+    LOG_ASSERT(lst_node != nullptr);
+    LOG_ASSERT(pos < lst->size);
+
+    if (lst->index != nullptr)
+    {
+$       list_node *idx_node = list_index_erase(lst->index, pos);
+        LOG_ASSERT(idx_node == lst_node);
+        (void) idx_node;
+    }
+
+    lst_node->prev->next = lst_node->next;
+    lst_node->next->prev = lst_node->prev;
+
+$   allocator_free(lst->alc, lst_node, list_node_size(lst->el_size));
+
+    lst->size--;
+$o
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void list_dtor(void *const _lst)
+{
+$i
+    if (_lst == nullptr) { $o return; }
+
+    list *const lst = (list *) _lst;
+$   LIST_VERIFY(lst, (void) 0);
+
+$   list_index_dtor    (lst);
+$   list_fictional_dtor(lst);
+$   list_own_slab_dtor (lst);
+    *lst = LST_POISON;
+$o
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void list_delete(void *const _lst)
+{
+$i
+$   list_dtor(_lst);
+$   LOG_FREE (_lst);
+$o
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void list_fictional_dtor(list *const lst)
+{
+$i
+$   LIST_ASSERT(lst);
+
+    if (list_is_exclusive_slab(lst) && lst->el_dtor == nullptr) { $o return; } // вершины освободит slab_dtor()
+
+    list_node *node_cur  = lst->fictional->next;
+    list_node *node_next = node_cur      ->next;
+
+$   for (; node_cur != lst->fictional;)
+    {
+        if (lst->el_dtor != nullptr) { lst->el_dtor(node_cur + 1); }
+        allocator_free(lst->alc, node_cur, list_node_size(lst->el_size));
+
+        node_cur  = node_next;
+        node_next = node_cur->next;
+    }
+
+$   allocator_free(lst->alc, lst->fictional, sizeof(list_node));
+$o
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static list_node *list_get_node(const list *const lst, const size_t pos)
+{
+$i
+$   LIST_ASSERT(lst);
+    LOG_ASSERT (pos <= lst->size);
+
+    list_node *cur_node = lst->fictional;
+
+    if (pos == lst->size)      { $o return cur_node; }
+    if (lst->index != nullptr) { $ cur_node = list_index_get(lst->index, pos); $o return cur_node; }
+
+    if (2 * pos <= lst->size) { for (size_t i =         0; i <= pos; ++i) cur_node = cur_node->next; }
+    else                      { for (size_t i = lst->size; i >  pos; --i) cur_node = cur_node->prev; }
+
+$o  return cur_node;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static list_node *list_find_node(const list *const lst, const void *const target, int (*el_cmp)(const void *el_1, const void *el_2), size_t *const pos)
+{
+$i
+$   LIST_ASSERT(lst);
+    LOG_ASSERT (target != nullptr);
+    LOG_ASSERT (pos    != nullptr);
+
+    size_t i = 0;
+$   for (list_node *cur_node = lst->fictional->next; cur_node != lst->fictional; cur_node = cur_node->next, ++i)
+    {
+        bool is_equal = (el_cmp != nullptr) ? el_cmp(cur_node + 1, target) == 0 :
+                                              strncmp((const char *) (cur_node + 1), (const char *) target, lst->el_size) == 0;
+        if (is_equal)
+        {
+            *pos = i;
+$o          return cur_node;
+        }
+    }
+
+$o  return nullptr;
+}
+
+//================================================================================================================================
+// INDEX
+//================================================================================================================================
+
+bool list_set_indexed(list *const lst, const bool is_indexed)
+{
+$i
+$   LIST_VERIFY(lst, false);
+
+    if (is_indexed == (lst->index != nullptr)) { $o return true; }
+
+    if (!is_indexed)
+    {
+$       list_index_dtor(lst);
+$o      return true;
+    }
+
+$   bool ret = list_index_ctor(lst);
+
+$   LIST_ASSERT(lst);
+$o  return ret;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static bool list_index_ctor(list *const lst)
+{
+$i
+    LOG_ASSERT(lst        != nullptr);
+    LOG_ASSERT(lst->index == nullptr);
+
+$   list_index *idx = (list_index *) LOG_CALLOC(1, sizeof(list_index));
+    if (idx == nullptr)
+    {
+$       LOG_ERROR("log_calloc(1, sizeof(list_index) = %lu) returns nullptr\n", sizeof(list_index));
+$o      return false;
+    }
+
+$   if (!slab_ctor(&idx->nodes, sizeof(list_index_node)))
+    {
+$       LOG_FREE(idx);
+$o      return false;
+    }
+
+    idx->rng = 0x9E3779B97F4A7C15UL ^ (uintptr_t) lst;
+
+    list_node *lst_node = lst->fictional->next;
+$   idx->root = list_index_build(idx, &lst_node, lst->size, 0);
+
+    if (idx->root == nullptr && lst->size != 0)
+    {
+$       slab_dtor(&idx->nodes);
+$       LOG_FREE (idx);
+$o      return false;
+    }
+
+    lst->index = idx;
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void list_index_dtor(list *const lst)
+{
+$i
+    LOG_ASSERT(lst != nullptr);
+
+    if (lst->index == nullptr) { $o return; }
+
+$   slab_dtor(&lst->index->nodes);
+$   LOG_FREE (lst->index);
+
+    lst->index = nullptr;
+$o
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Строит идеально сбалансированное дерево из size вершин листа, начиная с *lst_node, и сдвигает *lst_node за последнюю из них.
+*   Приоритет вершины на глубине depth берется из полуинтервала [2^(31 - depth), 2^(32 - depth)), поэтому свойство кучи
+*   выполняется сразу, а распределение приоритетов близко к тому, что дали бы случайные вставки.
+*/
+static list_index_node *list_index_build(list_index *const idx, list_node **const lst_node, const size_t size, const unsigned depth)
+{
+    LOG_ASSERT(idx      != nullptr);
+    LOG_ASSERT(lst_node != nullptr);
+
+    if (size == 0) return nullptr;
+
+    list_index_node *left = list_index_build(idx, lst_node, size / 2, depth + 1);
+    if (left == nullptr && size / 2 != 0) return nullptr;
+
+    uint32_t prio = 0;
+    if (depth < 32)
+    {
+        uint32_t band = 1U << (31 - depth);
+        prio = band | (list_index_rand(idx) & (band - 1));
+    }
+
+    list_index_node *idx_node = list_index_node_new(idx, *lst_node, prio);
+    if (idx_node == nullptr) return nullptr;
+
+    *lst_node = (*lst_node)->next;
+
+    idx_node->left  = left;
+    idx_node->right = list_index_build(idx, lst_node, size - size / 2 - 1, depth + 1);
+    if (idx_node->right == nullptr && size - size / 2 - 1 != 0) return nullptr;
+
+    list_index_update(idx_node);
+    return idx_node;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static list_index_node *list_index_node_new(list_index *const idx, list_node *const lst_node, const uint32_t prio)
+{
+    LOG_ASSERT(idx      != nullptr);
+    LOG_ASSERT(lst_node != nullptr);
+
+    list_index_node *idx_node = (list_index_node *) allocator_calloc(&idx->nodes.base, 1, sizeof(list_index_node));
+    if (idx_node == nullptr)
+    {
+        LOG_ERROR("allocator_calloc(1, sizeof(list_index_node) = %lu) returns nullptr\n", sizeof(list_index_node));
+        return nullptr;
+    }
+
+    idx_node->node = lst_node;
+    idx_node->size = 1;
+    idx_node->prio = prio;
+
+    return idx_node;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static uint32_t list_index_rand(list_index *const idx)
+{
+    LOG_ASSERT(idx != nullptr);
+
+    uint64_t x = idx->rng;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    idx->rng = x;
+
+    return (uint32_t) (x >> 32);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static inline size_t list_index_size(const list_index_node *const idx_node)
+{
+    return (idx_node == nullptr) ? 0 : idx_node->size;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static inline void list_index_update(list_index_node *const idx_node)
+{
+    LOG_ASSERT(idx_node != nullptr);
+
+    idx_node->size = list_index_size(idx_node->left) + list_index_size(idx_node->right) + 1;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Делит дерево: первые pos вершин уходят в *left, остальные - в *right.
+*/
+static void list_index_split(list_index_node *const idx_node, const size_t pos, list_index_node **const left,
+                                                                                list_index_node **const right)
+{
+    LOG_ASSERT(left  != nullptr);
+    LOG_ASSERT(right != nullptr);
+
+    if (idx_node == nullptr) { *left = *right = nullptr; return; }
+
+    size_t left_size = list_index_size(idx_node->left);
+
+    if (left_size < pos)
+    {
+        list_index_split(idx_node->right, pos - left_size - 1, &idx_node->right, right);
+        *left = idx_node;
+    }
+    else
+    {
+        list_index_split(idx_node->left, pos, left, &idx_node->left);
+        *right = idx_node;
+    }
+
+    list_index_update(idx_node);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static list_index_node *list_index_merge(list_index_node *const left, list_index_node *const right)
+{
+    if (left  == nullptr) return right;
+    if (right == nullptr) return left;
+
+    if (left->prio > right->prio)
+    {
+        left->right = list_index_merge(left->right, right);
+        list_index_update(left);
+        return left;
+    }
+
+    right->left = list_index_merge(left, right->left);
+    list_index_update(right);
+    return right;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static bool list_index_insert(list_index *const idx, list_node *const lst_node, const size_t pos)
+{
+$i
+    LOG_ASSERT(idx      != nullptr);
+    LOG_ASSERT(lst_node != nullptr);
+    LOG_ASSERT(pos <= list_index_size(idx->root));
+
+$   list_index_node *idx_node = list_index_node_new(idx, lst_node, list_index_rand(idx));
+    if (idx_node == nullptr) { $o return false; }
+
+    list_index_node *left  = nullptr;
+    list_index_node *right = nullptr;
+
+$   list_index_split(idx->root, pos, &left, &right);
+$   idx->root = list_index_merge(list_index_merge(left, idx_node), right);
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static list_node *list_index_erase(list_index *const idx, size_t pos)
+{
+$i
+    LOG_ASSERT(idx != nullptr);
+    LOG_ASSERT(pos < list_index_size(idx->root));
+
+    list_index_node **link = &idx->root;
+
+    for (;;)
+    {
+        list_index_node *idx_node  = *link;
+        size_t           left_size = list_index_size(idx_node->left);
+
+        idx_node->size--;
+
+        if      (pos <  left_size) { link = &idx_node->left; }
+        else if (pos == left_size) { break; }
+        else                       { link = &idx_node->right; pos -= left_size + 1; }
+    }
+
+    list_index_node *idx_node = *link;
+    list_node       *lst_node = idx_node->node;
+
+$   *link = list_index_merge(idx_node->left, idx_node->right);
+$   allocator_free(&idx->nodes.base, idx_node, sizeof(list_index_node));
+
+$o  return lst_node;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static list_node *list_index_get(const list_index *const idx, size_t pos)
+{
+    LOG_ASSERT(idx != nullptr);
+    LOG_ASSERT(pos < list_index_size(idx->root));
+
+    const list_index_node *idx_node = idx->root;
+
+    for (;;)
+    {
+        size_t left_size = list_index_size(idx_node->left);
+
+        if      (pos <  left_size) { idx_node = idx_node->left; }
+        else if (pos == left_size) { return idx_node->node; }
+        else                       { idx_node = idx_node->right; pos -= left_size + 1; }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static void list_index_free(list_index *const idx, list_index_node *const idx_node)
+{
+    LOG_ASSERT(idx != nullptr);
+
+    if (idx_node == nullptr) return;
+
+    list_index_free(idx, idx_node->left);
+    list_index_free(idx, idx_node->right);
+
+    allocator_free(&idx->nodes.base, idx_node, sizeof(list_index_node));
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   Обновляет индексы после переноса вершин [first, last) листа src (первая из них - first_node) на позицию pos листа dst.
+*   Внутри одного листа переставляет части дерева за O(log n). Между листами вырезает часть дерева src за O(k + log n)
+*   и вставляет в дерево dst поддерево, построенное за O(k).
+*/
+static void list_index_splice(list *const dst, const size_t pos, list *const src, const size_t first,
+                                                                                  const size_t last, list_node *const first_node)
+{
+$i
+    LOG_ASSERT(dst        != nullptr);
+    LOG_ASSERT(src        != nullptr);
+    LOG_ASSERT(first_node != nullptr);
+    LOG_ASSERT(first < last);
+
+    list_index_node *a    = nullptr;
+    list_index_node *b    = nullptr;
+    list_index_node *c    = nullptr;
+    list_index_node *d    = nullptr;
+    list_index_node *rest = nullptr;
+
+    if (dst == src)
+    {
+        list_index *idx = dst->index;
+        if (idx == nullptr) { $o return; }
+
+        if (pos <= first) // a = [0, pos), b = [pos, first), c = [first, last), d = [last, size) -> a c b d
+        {
+            list_index_split(idx->root, pos        , &a, &rest);
+            list_index_split(rest     , first - pos, &b, &rest);
+            list_index_split(rest     , last - first, &c, &d);
+
+            idx->root = list_index_merge(list_index_merge(a, c), list_index_merge(b, d));
+        }
+        else // a = [0, first), c = [first, last), b = [last, pos), d = [pos, size) -> a b c d
+        {
+            list_index_split(idx->root, first       , &a, &rest);
+            list_index_split(rest     , last - first, &c, &rest);
+            list_index_split(rest     , pos - last  , &b, &d);
+
+            idx->root = list_index_merge(list_index_merge(a, b), list_index_merge(c, d));
+        }
+$o      return;
+    }
+
+    if (src->index != nullptr)
+    {
+        list_index_split(src->index->root, first       , &a, &rest);
+        list_index_split(rest            , last - first, &c, &d);
+
+$       list_index_free(src->index, c);
+        src->index->root = list_index_merge(a, d);
+    }
+
+    if (dst->index != nullptr)
+    {
+        list_node *lst_node = first_node;
+$       c = list_index_build(dst->index, &lst_node, last - first, 0);
+
+        if (c == nullptr)
+        {
+$           LOG_WARNING("can't update the list index, it is switched off\n");
+$           list_index_dtor(dst);
+$o          return;
+        }
+
+        list_index_split(dst->index->root, pos, &a, &d);
+        dst->index->root = list_index_merge(list_index_merge(a, c), d);
+    }
+$o
+}
+
+//================================================================================================================================
+// SPLICE
+//================================================================================================================================
+
+bool list_splice(list *const dst, const size_t pos, list *const src, const size_t first, const size_t last)
 {
 $i
-    LOG_VERIFY(lst != nullptr, false);
-    LOG_VERIFY(el_size > 0UL , false);
+$   LIST_VERIFY(dst, false);
+$   LIST_VERIFY(src, false);
+    LOG_VERIFY (dst->el_size == src->el_size, false);
+    LOG_VERIFY (first <= last           , false);
+    LOG_VERIFY (last  <= src->size      , false);
+    LOG_VERIFY (pos   <= dst->size      , false);
+    LOG_VERIFY (dst != src || pos <= first || pos >= last, false);
 
-    lst->size    = 0;
-    lst->el_size = el_size;
-    lst->el_dtor = el_dtor;
-    lst->el_dump = el_dump;
+    if (first == last)                                  { $o return true; }
+    if (dst == src && (pos == first || pos == last))    { $o return true; }
+    if (!list_is_relinkable(dst, src)) { $ bool ret = list_splice_copy(dst, pos, src, first, last); $o return ret; }
 
-$   if (!list_fictional_ctor(lst)) { $o return false; }
+    const size_t count = last - first;
 
-$   LIST_ASSERT(lst);
+$   list_node *first_node = list_get_node(src, first);
+$   list_node *last_node  = list_get_node(src, last)->prev;
+$   list_node *dest_node  = list_get_node(dst, pos);
+
+$   list_index_splice(dst, pos, src, first, last, first_node);
+
+    first_node->prev->next = last_node->next;
+    last_node->next->prev  = first_node->prev;
+
+    first_node->prev = dest_node->prev;
+    last_node ->next = dest_node;
+
+    dest_node->prev->next = first_node;
+    dest_node->prev       = last_node;
+
+    src->size -= count;
+    dst->size += count;
+
+$   LIST_ASSERT(dst);
+$   LIST_ASSERT(src);
 $o  return true;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-list *list_new(const size_t el_size, void (*el_dtor) (      void *const) /* = nullptr */,
-                                     void (*el_dump) (const void *const) /* = nullptr */)
+/**
+*   Перенос между листами с разными аллокаторами: вершины нельзя перевесить, поэтому элементы копируются побайтово
+*   в новые вершины dst, а старые вершины src освобождаются без вызова el_dtor.
+*   Все вершины dst выделяются до изменения листов, так что при нехватке памяти оба листа остаются нетронутыми.
+*/
+static bool list_splice_copy(list *const dst, const size_t pos, list *const src, const size_t first, const size_t last)
 {
 $i
-$   list *lst = (list *) LOG_CALLOC(1, sizeof(list));
-    if (lst == nullptr)
-    {
-$       LOG_ERROR("log_calloc(1, sizeof(list) = %lu) returns nullptr\n", sizeof(list));
-$o      return nullptr;
-    }
-$   if (!list_ctor(lst, el_size, el_dtor, el_dump))
+    LOG_ASSERT(dst != src);
+    LOG_ASSERT(first < last);
+
+    const size_t count = last - first;
+
+$   list_node *new_first = list_nodes_alloc(dst, count);
+    if (new_first == nullptr) { $o return false; }
+
+$   list_node *src_node  = list_get_node(src, first);
+$   list_node *dest_node = list_get_node(dst, pos);
+    list_node *src_prev  = src_node->prev;
+    list_node *new_node  = new_first;
+    list_node *new_last  = nullptr;
+
+$   list_index_splice(dst, pos, src, first, last, new_first);
+
+    for (size_t i = 0; i < count; ++i)
     {
-        LOG_FREE(lst);
-$o      return nullptr;
+        list_node *src_next = src_node->next;
+
+        memcpy(new_node + 1, src_node + 1, dst->el_size);
+        allocator_free(src->alc, src_node, list_node_size(src->el_size));
+
+        new_node->prev = new_last;
+        new_last = new_node;
+        new_node = new_node->next;
+        src_node = src_next;
     }
 
-$   LIST_ASSERT(lst);
-$o  return lst;
+    src_prev->next = src_node;
+    src_node->prev = src_prev;
+
+    new_first->prev = dest_node->prev;
+    new_last ->next = dest_node;
+
+    dest_node->prev->next = new_first;
+    dest_node->prev       = new_last;
+
+    src->size -= count;
+    dst->size += count;
+
+$   LIST_ASSERT(dst);
+$   LIST_ASSERT(src);
+$o  return true;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static bool list_fictional_ctor(list *const lst)
+/**
+*   @brief Выделяет count > 0 вершин листа цепочкой, связанной через next (next последней вершины - nullptr).
+*   Если памяти не хватило, уже выделенные вершины освобождаются.
+*
+*   @return первая вершина цепочки или nullptr в случае ошибки.
+*/
+static list_node *list_nodes_alloc(list *const lst, const size_t count)
 {
 $i
     LOG_ASSERT(lst != nullptr);
+    LOG_ASSERT(count > 0);
 
-$   lst->fictional = (list_node *) LOG_CALLOC(1, sizeof(list_node));
-    if (lst->fictional == nullptr)
+    list_node *first = nullptr;
+    list_node *last  = nullptr;
+
+    for (size_t i = 0; i < count; ++i)
     {
-$       LOG_ERROR("log_calloc(1, sizeof(list_node) = %lu) returns nullptr\n", sizeof(list_node));
-$o      return false;
-    }
+        list_node *lst_node = (list_node *) allocator_calloc(lst->alc, 1, list_node_size(lst->el_size));
+        if (lst_node == nullptr)
+        {
+$           LOG_ERROR("allocator_calloc(1, sizeof(list_node) = %lu + el_size = %lu) returns nullptr\n",
+                                     sizeof(list_node),   lst->el_size);
+$           list_nodes_free(lst, first);
+$o          return nullptr;
+        }
 
-    lst->fictional->prev = lst->fictional;
-    lst->fictional->next = lst->fictional;
+        if (last == nullptr) first      = lst_node;
+        else                 last->next = lst_node;
 
-$   LIST_ASSERT(lst);
-$o  return true;
+        last = lst_node;
+    }
+
+$o  return first;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static bool list_node_new(list *const lst, const void      *const data,
-                                           const list_node *const prev,
-                                           const list_node *const next)
+/**
+*   @brief Освобождает цепочку вершин, выделенную list_nodes_alloc().
+*/
+static void list_nodes_free(list *const lst, list_node *chain)
 {
 $i
-$   LIST_ASSERT(lst);
-    LOG_ASSERT (data != nullptr);
-    LOG_ASSERT (prev != nullptr);
-    LOG_ASSERT (next != nullptr);
+    LOG_ASSERT(lst != nullptr);
 
-    list_node *lst_node = (list_node *) LOG_CALLOC(1, sizeof(list_node) + lst->el_size);
-    if (lst_node == nullptr)
+    while (chain != nullptr)
     {
-$       LOG_ERROR("log_calloc(1, sizeof(list_node) = %lu + el_size = %lu) returns nullptr\n",
-                                 sizeof(list_node),   lst->el_size);
-$o      return false;
+        list_node *next = chain->next;
+        allocator_free(lst->alc, chain, list_node_size(lst->el_size));
+        chain = next;
     }
-$   list_node_ctor(lst, lst_node, data, prev, next);
-
-$o  return true;
+$o
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wcast-qual"
-
-static void list_node_ctor(list      *const lst,
-                           list_node *const lst_node, const void      *const data,
-                                                      const list_node *const prev,
-                                                      const list_node *const next)
+bool list_concat(list *const dst, list *const src)
 {
 $i
-$   LIST_ASSERT(lst);
-    LOG_ASSERT (lst_node != nullptr);
-    LOG_ASSERT (data     != nullptr);
-    LOG_ASSERT (prev     != nullptr);
-    LOG_ASSERT (next     != nullptr);
-
-    lst_node->prev = (list_node *) prev; lst_node->prev->next = lst_node;
-    lst_node->next = (list_node *) next; lst_node->next->prev = lst_node;
-$   memcpy(lst_node + 1, data, lst->el_size);
+$   LIST_VERIFY(dst, false);
+$   LIST_VERIFY(src, false);
+    LOG_VERIFY (dst != src, false);
 
-    lst->size++;
-$o
+$   bool   ret = list_splice(dst, dst->size, src, 0, src->size);
+$o  return ret;
 }
 
-#pragma GCC diagnostic pop
-
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static bool list_node_delete(list      *const lst,
-                             list_node *const lst_node, void *const erased_data)
+bool list_merge(list *const dst, list *const src, int (*el_cmp)(const void *el_1, const void *el_2))
 {
 $i
-$   LIST_ASSERT(lst);
-    LOG_ASSERT (lst_node != nullptr);
+$   LIST_VERIFY(dst, false);
+$   LIST_VERIFY(src, false);
+    LOG_VERIFY (dst    != src    , false);
+    LOG_VERIFY (el_cmp != nullptr, false);
+    LOG_VERIFY (dst->el_size == src->el_size, false);
 
-    void *erased_el = lst_node + 1;
-    list_node *prev = lst_node->prev;
-    list_node *next = lst_node->next;
+$   const bool is_relink = list_is_relinkable(dst, src);
+    list_node *spare     = nullptr; // вершины dst под копии элементов src, если вершины нельзя перевесить
 
-    prev->next = next;
-    next->prev = prev;
+    if (!is_relink && src->size != 0)
+    {
+$       spare = list_nodes_alloc(dst, src->size);
+        if (spare == nullptr) { $o return false; }
+    }
 
-    if (erased_data  != nullptr) memcpy(erased_data, erased_el, lst->el_size);
-    if (lst->el_dtor != nullptr) { $ lst->el_dtor(erased_el); }
-$   LOG_FREE(lst_node);
+    const bool is_dst_indexed = dst->index != nullptr;
+    const bool is_src_indexed = src->index != nullptr;
 
-    lst->size--;
+$   list_index_dtor(dst);
+$   list_index_dtor(src);
 
-$   LIST_ASSERT(lst);
+    list_node *dest_node = dst->fictional->next;
+    list_node *src_node  = src->fictional->next;
+
+$   while (src_node != src->fictional)
+    {
+        if (dest_node != dst->fictional && el_cmp(src_node + 1, dest_node + 1) >= 0) { dest_node = dest_node->next; continue; }
+
+        list_node *src_next = src_node->next;
+
+        if (is_relink)
+        {
+            src_node->prev->next = src_node->next;
+            src_node->next->prev = src_node->prev;
+
+            src_node->prev = dest_node->prev;
+            src_node->next = dest_node;
+
+            dest_node->prev->next = src_node;
+            dest_node->prev       = src_node;
+
+            src->size--;
+            dst->size++;
+        }
+        else
+        {
+            list_node *new_node = spare;
+            spare = spare->next;
+
+$           list_node_ctor  (dst, new_node, src_node + 1, dest_node->prev, dest_node);
+$           list_node_unlink(src, src_node, 0);
+        }
+
+        src_node = src_next;
+    }
+
+    if (is_dst_indexed && !list_index_ctor(dst)) { $ LOG_WARNING("can't rebuild the list index, it is switched off\n"); }
+    if (is_src_indexed && !list_index_ctor(src)) { $ LOG_WARNING("can't rebuild the list index, it is switched off\n"); }
+
+$   LIST_ASSERT(dst);
+$   LIST_ASSERT(src);
 $o  return true;
 }
 
-//--------------------------------------------------------------------------------------------------------------------------------
+//================================================================================================================================
+// SORT
+//================================================================================================================================
 
-void list_dtor(void *const _lst)
+bool list_sort(list *const lst, int (*el_cmp)(const void *el_1, const void *el_2))
 {
 $i
-    if (_lst == nullptr) { $o return; }
+$   LIST_VERIFY(lst, false);
+    LOG_VERIFY (el_cmp != nullptr, false);
 
-    list *const lst = (list *) _lst;
-$   LIST_VERIFY(lst, (void) 0);
+    if (lst->size < 2) { $o return true; }
 
-$   list_fictional_dtor(lst);
-    *lst = LST_POISON;
-$o
-}
+    list_node *bins[LIST_SORT_BIN_COUNT] = {};
+    size_t     bins_used                 = 0;
 
-//--------------------------------------------------------------------------------------------------------------------------------
+    lst->fictional->prev->next = nullptr;
+    list_node *node_cur        = lst->fictional->next;
 
-void list_delete(void *const _lst)
-{
-$i
-$   list_dtor(_lst);
-$   LOG_FREE (_lst);
-$o
-}
+$   while (node_cur != nullptr)
+    {
+        list_node *node_next = node_cur->next;
+        node_cur->next = nullptr;
 
-//--------------------------------------------------------------------------------------------------------------------------------
+        list_node *run = node_cur;
+        size_t     i   = 0;
 
-static void list_fictional_dtor(list *const lst)
-{
-$i
-$   LIST_ASSERT(lst);
+        for (; i < bins_used && bins[i] != nullptr; ++i)
+        {
+            run     = list_sort_merge(bins[i], run, el_cmp);
+            bins[i] = nullptr;
+        }
+        if (i == bins_used) bins_used++;
+        bins[i] = run;
 
-    list_node *node_cur  = lst->fictional->next;
-    list_node *node_next = node_cur      ->next;
+        node_cur = node_next;
+    }
 
-$   for (; node_cur != lst->fictional;)
+    list_node *sorted = nullptr;
+$   for (size_t i = 0; i < bins_used; ++i)
     {
-        if (lst->el_dtor != nullptr) { lst->el_dtor(node_cur + 1); }
-        LOG_FREE(node_cur);
+        if (bins[i] != nullptr) sorted = (sorted == nullptr) ? bins[i] : list_sort_merge(bins[i], sorted, el_cmp);
+    }
 
-        node_cur  = node_next;
-        node_next = node_cur->next;
+    list_node *prev_node = lst->fictional;
+$   for (node_cur = sorted; node_cur != nullptr; node_cur = node_cur->next)
+    {
+        prev_node->next = node_cur;
+        node_cur ->prev = prev_node;
+        prev_node       = node_cur;
     }
+    prev_node     ->next = lst->fictional;
+    lst->fictional->prev = prev_node;
 
-$   LOG_FREE(lst->fictional);
-$o
+    if (lst->index != nullptr)
+    {
+$       list_index_dtor(lst);
+$       if (!list_index_ctor(lst)) { $ LOG_WARNING("can't rebuild the list index, it is switched off\n"); }
+    }
+
+$   LIST_ASSERT(lst);
+$o  return true;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static list_node *list_get_node(const list *const lst, const size_t pos)
+/**
+*   Сливает две отсортированные цепочки вершин, связанные только через next и оканчивающиеся nullptr.
+*   Из равных элементов первыми идут элементы left.
+*/
+static list_node *list_sort_merge(list_node *left, list_node *right, int (*el_cmp)(const void *el_1, const void *el_2))
 {
-$i
-$   LIST_ASSERT(lst);
-    LOG_ASSERT (pos <= lst->size);
+    LOG_ASSERT(left   != nullptr);
+    LOG_ASSERT(right  != nullptr);
+    LOG_ASSERT(el_cmp != nullptr);
 
-    list_node *cur_node = lst->fictional;
+    list_node  head = {};
+    list_node *tail = &head;
 
-    if (2 * pos <= lst->size) { for (size_t i =         0; i <= pos; ++i) cur_node = cur_node->next; }
-    else                      { for (size_t i = lst->size; i >  pos; --i) cur_node = cur_node->prev; }
+    while (left != nullptr && right != nullptr)
+    {
+        if (el_cmp(right + 1, left + 1) < 0) { tail->next = right; right = right->next; }
+        else                                 { tail->next = left ; left  = left ->next; }
 
-$o  return cur_node;
+        tail = tail->next;
+    }
+    tail->next = (left != nullptr) ? left : right;
+
+    return head.next;
 }
 
-//--------------------------------------------------------------------------------------------------------------------------------
+//================================================================================================================================
 
 void list_clear(list *const lst)
 {
@@ -344,12 +1341,11 @@ $   LIST_VERIFY(lst              , false);
     LOG_VERIFY (pos  <= lst->size, false);
 
     list_node *prev_node = nullptr;
-    list_node *next_node = nullptr;
 
-    if (pos == 0) {   prev_node = lst->fictional;              next_node = lst->fictional->next; }
-    else          { $ prev_node = list_get_node(lst, pos - 1); next_node = prev_node     ->next; }
+    if (pos == 0) {   prev_node = lst->fictional;              }
+    else          { $ prev_node = list_get_node(lst, pos - 1); }
 
-$   bool ret = list_node_new(lst, data, prev_node, next_node);
+$   bool ret = list_insert_after(lst, data, prev_node, pos);
 
 $   LIST_ASSERT(lst);
 $o  return ret;
@@ -357,6 +1353,26 @@ $o  return ret;
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
+static bool list_insert_after(list *const lst, const void *const data, list_node *const prev_node, const size_t pos)
+{
+$i
+    LOG_ASSERT(lst       != nullptr);
+    LOG_ASSERT(prev_node != nullptr);
+    LOG_ASSERT(pos <= lst->size);
+
+$   if (!list_node_new(lst, data, prev_node, prev_node->next)) { $o return false; }
+
+    if (lst->index != nullptr && !list_index_insert(lst->index, prev_node->next, pos))
+    {
+$       LOG_WARNING("can't update the list index, it is switched off\n");
+$       list_index_dtor(lst);
+    }
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
 bool list_push_front(list *const lst, const void *const data)
 {
 $i
@@ -384,7 +1400,7 @@ $   LIST_VERIFY(lst, false);
     LOG_VERIFY (pos < lst->size, false);
 
 $   list_node *cur_node = list_get_node(lst, pos);
-$   list_node_delete(lst, cur_node, erased_data);
+$   list_node_delete(lst, cur_node, pos, erased_data);
 
 $   LIST_ASSERT(lst);
 $o  return true;
@@ -397,11 +1413,13 @@ bool list_erase(list *const lst, const void *const target, int (*el_cmp)(const v
 $i
 $   LIST_VERIFY(lst, false);
 
-$   void *el_to_erase = list_find(lst, target, el_cmp);
-    if (el_to_erase == nullptr) { $o return false; }
+    LOG_VERIFY (target != nullptr, false);
 
-    list_node *node_to_erase = (list_node *) el_to_erase - 1;
-$   list_node_delete(lst, node_to_erase, erased_data);
+    size_t pos = 0;
+$   list_node *node_to_erase = list_find_node(lst, target, el_cmp, &pos);
+    if (node_to_erase == nullptr) { $o return false; }
+
+$   list_node_delete(lst, node_to_erase, pos, erased_data);
 
 $   LIST_ASSERT(lst);
 $o  return true;
@@ -601,13 +1619,142 @@ $   if (dest_prev_pos < 0) dest_prev_node = lst->fictional;
     else                   dest_prev_node = list_get_node(lst, (size_t) dest_prev_pos);
 
 $   list_replace(src_node, dest_prev_node);
+
+    if (lst->index != nullptr)
+    {
+$       list_index_erase(lst->index, src_pos);
+$       if (!list_index_insert(lst->index, src_node, dest_pos))
+        {
+$           LOG_WARNING("can't update the list index, it is switched off\n");
+$           list_index_dtor((list *) lst);
+        }
+    }
+
 $o  return true;
 }
 
 #pragma GCC diagnostic pop
 
+//================================================================================================================================
+// CURSOR
+//================================================================================================================================
+
+bool list_cursor_ctor(list_cursor *const cur, list *const lst, const size_t pos /* = 0 */)
+{
+$i
+    LOG_VERIFY (cur != nullptr, false);
+$   LIST_VERIFY(lst, false);
+    LOG_VERIFY (pos <= lst->size, false);
+
+    cur->lst  = lst;
+$   cur->node = list_get_node(lst, pos);
+    cur->pos  = pos;
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void *list_cursor_get(const list_cursor *const cur)
+{
+$i
+    LOG_VERIFY(cur      != nullptr, nullptr);
+    LOG_VERIFY(cur->lst != nullptr, nullptr);
+    LOG_ASSERT(cur->pos <= cur->lst->size);
+
+    if (cur->node == cur->lst->fictional) { $o return nullptr; }
+$o  return cur->node + 1;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool list_cursor_advance(list_cursor *const cur, const long step /* = 1 */)
+{
+$i
+    LOG_VERIFY(cur      != nullptr, false);
+    LOG_VERIFY(cur->lst != nullptr, false);
+    LOG_ASSERT(cur->pos <= cur->lst->size);
+
+    // 0 - (size_t) step, а не -step: -LONG_MIN не помещается в long
+    if (step >= 0 &&     (size_t) step > cur->lst->size - cur->pos) { $o return false; }
+    if (step <  0 && 0 - (size_t) step > cur->pos)                  { $o return false; }
+
+    list_node *node = cur->node;
+
+    if (step >= 0) { for (long i = 0; i < step; ++i) node = node->next; }
+    else           { for (long i = 0; i > step; --i) node = node->prev; }
+
+    cur->node = node;
+    cur->pos  = (size_t) ((long) cur->pos + step);
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool list_cursor_seek(list_cursor *const cur, const size_t pos)
+{
+$i
+    LOG_VERIFY(cur      != nullptr, false);
+    LOG_VERIFY(cur->lst != nullptr, false);
+    LOG_VERIFY(pos <= cur->lst->size, false);
+
+    const list *lst = cur->lst;
+
+    size_t from_cur  = (pos > cur->pos) ? pos - cur->pos : cur->pos - pos;
+    size_t from_ends = (2 * pos <= lst->size) ? pos + 1 : lst->size - pos;
+
+    if (from_cur <= from_ends && (lst->index == nullptr || from_cur < LIST_CURSOR_INDEX_MIN_STEP))
+    {
+$       bool   ret = list_cursor_advance(cur, (long) pos - (long) cur->pos);
+$o      return ret;
+    }
+
+$   cur->node = list_get_node(lst, pos);
+    cur->pos  = pos;
+
+$o  return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool list_cursor_insert_before(list_cursor *const cur, const void *const data)
+{
+$i
+    LOG_VERIFY (cur  != nullptr, false);
+    LOG_VERIFY (data != nullptr, false);
+$   LIST_VERIFY(cur->lst, false);
+    LOG_ASSERT (cur->pos <= cur->lst->size);
+
+$   if (!list_insert_after(cur->lst, data, cur->node->prev, cur->pos)) { $o return false; }
+    cur->pos++;
+
+$   LIST_ASSERT(cur->lst);
+$o  return true;
+}
+
 //--------------------------------------------------------------------------------------------------------------------------------
 
+bool list_cursor_erase(list_cursor *const cur, void *const erased_data /* = nullptr */)
+{
+$i
+    LOG_VERIFY (cur != nullptr, false);
+$   LIST_VERIFY(cur->lst, false);
+    LOG_VERIFY (cur->pos < cur->lst->size, false);
+
+    list_node *next_node = cur->node->next;
+
+$   list_node_delete(cur->lst, cur->node, cur->pos, erased_data);
+    cur->node = next_node;
+
+$   LIST_ASSERT(cur->lst);
+$o  return true;
+}
+
+//================================================================================================================================
+// DUMP
+//================================================================================================================================
+
 void list_dump(const void *const _lst)
 {
 $i
@@ -694,6 +1841,16 @@ $i
     else if (lst->fictional == nullptr)              { $ ERROR_FIELD_DUMP ("fictional", "%p", nullptr); is_any_invalid = true; }
     else                                             { $ USUAL_FIELD_DUMP ("fictional", "%p", lst->fictional); }
 
+    if      (lst->alc == LST_POISON.alc)             { $ POISON_FIELD_DUMP("alc      ");                is_any_invalid = true; }
+    else if (lst->alc == nullptr)                    { $ ERROR_FIELD_DUMP ("alc      ", "%p", nullptr); is_any_invalid = true; }
+    else                                             { $ USUAL_FIELD_DUMP ("alc      ", "%p", lst->alc); }
+
+    if      (lst->own_slab == LST_POISON.own_slab)   { $ POISON_FIELD_DUMP("own_slab ");                is_any_invalid = true; }
+    else                                             { $ USUAL_FIELD_DUMP ("own_slab ", "%p", lst->own_slab); }
+
+    if      (lst->index == LST_POISON.index)         { $ POISON_FIELD_DUMP("index    ");                is_any_invalid = true; }
+    else                                             { $ USUAL_FIELD_DUMP ("index    ", "%p", lst->index); }
+
 $   LOG_MESSAGE("\n");
 $o  return is_any_invalid;
 }
@@ -4,12 +4,53 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 
 #include "log.h"
 #include "list.h"
 
 //================================================================================================================================
 
+/**
+*   @brief Вершина позиционного индекса: декартово дерево по неявному ключу (порядковому номеру в листе).
+*/
+struct list_index_node
+{
+    list_index_node *left;  ///< левое поддерево (элементы до вершины)
+    list_index_node *right; ///< правое поддерево (элементы после вершины)
+    list_node       *node;  ///< вершина листа
+    size_t           size;  ///< количество вершин в поддереве
+    uint32_t         prio;  ///< приоритет (куча по приоритетам)
+};
+
+/**
+*   @brief Позиционный индекс листа.
+*/
+struct list_index
+{
+    list_index_node *root;  ///< корень дерева
+    slab             nodes; ///< slab вершин дерева
+    uint64_t         rng;   ///< состояние генератора приоритетов (xorshift64)
+};
+
+/**
+*   @brief Собственный slab листа.
+*   Листы, между которыми переносятся вершины, объединяют собственные slab-ы в группу (лес с корнем, как в системе
+*   непересекающихся множеств): память всех slab-ов группы переносится в slab корня, остальные только переадресуют ему вызовы.
+*   Поиск корня сжимает путь, а меньшая по числу листов группа подвешивается к большей, так что цепочки остаются короткими.
+*   Поэтому list->alc у листа не меняется, а вершина, выделенная одним листом группы, может быть освобождена другим.
+*/
+struct list_slab
+{
+    allocator  base;    ///< интерфейс аллокатора, переадресующий вызовы slab-у корня группы
+    slab       nodes;   ///< slab вершин (пустой, если это не корень группы)
+    list_slab *parent;  ///< slab, в который перенесена память этого (nullptr у корня группы)
+    size_t     refs;    ///< количество листов и slab-ов, ссылающихся на этот
+    size_t     lists;   ///< количество листов в группе (поддерживается только у корня)
+};
+
+//================================================================================================================================
+
 /**
 *   @brief Типы ошибок в листе.
 */
@@ -23,11 +64,14 @@ typedef enum
     LST_POISON_EL_SIZE      ,   ///< .el_size   = LST_POISON.el_size
     LST_POISON_EL_DTOR      ,   ///< .el_dtor   = LST_POISON.el_dtor
     LST_POISON_EL_DUMP      ,   ///< .el_dump   = LST_POISON.el_dump
+    LST_POISON_INDEX        ,   ///< .index     = LST_POISON.index
 
     LST_NULLPTR_FICTIONAL   ,   ///< .fictional = nullptr
+    LST_NULLPTR_ALC         ,   ///< .alc       = nullptr
 
     LST_INVALID_NODE        ,   ///< .prev = nullpttr || .next = nullptr
     LST_INVALID_CYCLE       ,   ///< нарушен цикл
+    LST_INVALID_INDEX       ,   ///< индекс не соответствует листу
 }
 LST_STATUS_TYPE;
 
@@ -46,11 +90,14 @@ static const char *LST_STATUS_MESSAGES[] =
     "list.el_size"" is poison"  ,
     "list.el_dtor"" is poison"  ,
     "list.el_dump"" is poison"  ,
+    "list.index"  " is poison"  ,
 
     "list.fictional is invalid" ,
+    "list.alc is nullptr"       ,
 
     "list node"   " is invalid" ,
     "list cycle"  " is invalid" ,
+    "list index"  " is invalid" ,
 };
 
 static const list LST_POISON =
@@ -62,23 +109,69 @@ static const list LST_POISON =
 
     .el_dtor = (void (*)(      void *)) 0xABADBABE,
     .el_dump = (void (*)(const void *)) 0xABADB002,
+
+    .alc      = (allocator *) 0xDEFEC8ED,
+    .own_slab = (list_slab *) 0xBAADF00D,
+
+    .index = (list_index *) 0xD15EA5ED,
 };
 
+static const size_t LIST_SORT_BIN_COUNT        = 64; ///< количество корзин list_sort(): в корзине i лежит отсортированная цепочка из 2^i вершин
+static const size_t LIST_CURSOR_INDEX_MIN_STEP = 64; ///< расстояние от курсора, начиная с которого list_cursor_seek() идет через индекс листа
+
 //================================================================================================================================
 
 static void       list_log_error         (const list *const lst, const unsigned err);
 static unsigned   list_fields_verify     (const list *const lst);
 static unsigned   list_cycle_verify      (const list *const lst);
 static unsigned   list_node_verify       (const list_node *const lst_node);
+static unsigned   list_index_verify      (const list *const lst);
+static bool       list_index_order_verify(const list_index_node *const idx_node, const list_node **const lst_node);
+
+static bool       list_own_slab_ctor     (list *const lst);
+static void       list_own_slab_dtor     (list *const lst);
+static bool       list_is_exclusive_slab (const list *const lst);
+static bool       list_is_relinkable     (list *const dst, list *const src);
+
+static list_slab *list_slab_root         (list_slab *ls);
+static void       list_slab_join         (list_slab *const ls_1, list_slab *const ls_2);
+static void       list_slab_release      (list_slab *ls);
+static void      *list_slab_alloc        (allocator *const alc, const size_t size);
+static void      *list_slab_realloc      (allocator *const alc, void *const ptr, const size_t old_size, const size_t new_size);
+static void       list_slab_free         (allocator *const alc, void *const ptr, const size_t size);
 
 static bool       list_fictional_ctor    (list *const lst);
 static void       list_fictional_dtor    (list *const lst);
 
 static bool       list_node_new          (list *const lst,                            const void *const data, const list_node *const prev, const list_node *const next);
 static void       list_node_ctor         (list *const lst, list_node *const lst_node, const void *const data, const list_node *const prev, const list_node *const next);
-static bool       list_node_delete       (list *const lst, list_node *const lst_node, void *const erased_data);
+static bool       list_node_delete       (list *const lst, list_node *const lst_node, const size_t pos, void *const erased_data);
+static void       list_node_unlink       (list *const lst, list_node *const lst_node, const size_t pos);
+
+static list_node *list_sort_merge        (list_node *left, list_node *right, int (*el_cmp)(const void *el_1, const void *el_2));
+
+static bool       list_splice_copy       (list *const dst, const size_t pos, list *const src, const size_t first, const size_t last);
+static list_node *list_nodes_alloc       (list *const lst, const size_t count);
+static void       list_nodes_free        (list *const lst, list_node *chain);
 
 static list_node *list_get_node          (const list *const lst, const size_t index);
+static bool       list_insert_after      (list *const lst, const void *const data, list_node *const prev_node, const size_t pos);
+static list_node *list_find_node         (const list *const lst, const void *const target, int (*el_cmp)(const void *el_1, const void *el_2), size_t *const pos);
+
+static bool             list_index_ctor     (list *const lst);
+static void             list_index_dtor     (list *const lst);
+static list_index_node *list_index_build    (list_index *const idx, list_node **const lst_node, const size_t size, const unsigned depth);
+static list_index_node *list_index_node_new (list_index *const idx, list_node *const lst_node, const uint32_t prio);
+static uint32_t         list_index_rand     (list_index *const idx);
+static inline size_t    list_index_size     (const list_index_node *const idx_node);
+static inline void      list_index_update   (list_index_node *const idx_node);
+static void             list_index_split    (list_index_node *const idx_node, const size_t pos, list_index_node **const left, list_index_node **const right);
+static list_index_node *list_index_merge    (list_index_node *const left, list_index_node *const right);
+static bool             list_index_insert   (list_index *const idx, list_node *const lst_node, const size_t pos);
+static list_node       *list_index_erase    (list_index *const idx, const size_t pos);
+static list_node       *list_index_get      (const list_index *const idx, const size_t pos);
+static void             list_index_free     (list_index *const idx, list_index_node *const idx_node);
+static void             list_index_splice   (list *const dst, const size_t pos, list *const src, const size_t first, const size_t last, list_node *const first_node);
 
 static void       list_replace           (list_node *src_node, list_node *dest_prev_node);
 
@@ -13,10 +13,12 @@ static void source_pos_dump(const void *const src_pos_);
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
+static const size_t TRACE_INLINE_DEPTH = 64; ///< глубина стека вызовов, до которой trace не использует динамическую память
+
 struct trace
 {
-    source_pos cur_pos;
-    stack      stack_trace;
+    source_pos                                  cur_pos;
+    small_stack<source_pos, TRACE_INLINE_DEPTH> stack_trace;
 };
 
 //================================================================================================================================
@@ -34,23 +36,23 @@ bool trace_ctor()
         .line = __LINE__
     };
 
-    return stack_ctor(&TRACE.stack_trace, sizeof(source_pos), nullptr, nullptr, source_pos_dump);
+    return small_stack_ctor(&TRACE.stack_trace, nullptr, nullptr, source_pos_dump);
 }
 
 void trace_dtor()
 {
-    stack_dtor(&TRACE.stack_trace);
+    stack_dtor(&TRACE.stack_trace.base);
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-void trace_push() { stack_push(&TRACE.stack_trace, &TRACE.cur_pos); }
-void trace_pop () { stack_pop (&TRACE.stack_trace, &TRACE.cur_pos); }
+void trace_push() { stack_push(&TRACE.stack_trace.base, &TRACE.cur_pos); }
+void trace_pop () { stack_pop (&TRACE.stack_trace.base, &TRACE.cur_pos); }
 void trace_dump()
 {
-    stack_push(&TRACE.stack_trace, &TRACE.cur_pos);
-    stack_dump(&TRACE.stack_trace);
-    stack_pop (&TRACE.stack_trace);
+    stack_push(&TRACE.stack_trace.base, &TRACE.cur_pos);
+    stack_dump(&TRACE.stack_trace.base);
+    stack_pop (&TRACE.stack_trace.base);
 }
 
 void trace_upd_pos(const char *file, const char *func, const int line)
@@ -63,7 +65,7 @@ void trace_upd_pos(const char *file, const char *func, const int line)
     };
 }
 
-size_t trace_get_size() { return TRACE.stack_trace.size; }
+size_t trace_get_size() { return TRACE.stack_trace.base.size; }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
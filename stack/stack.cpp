@@ -6,15 +6,53 @@
 // STACK
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static void stack_gap_fill_poison(stack *const stk)
+/*
+*   POISON-значения в неиспользуемых ячейках [size, capacity) нужны только верификатору, поэтому их обработка зависит от сборки:
+*   - с верификацией ячейки заполняются при создании стека, при росте (только новые ячейки [old_capacity, new_capacity))
+*     и при удалении элементов. Отладочная сборка проверяет весь промежуток, сборка без _DEBUG - не больше STK_GAP_SAMPLES ячеек;
+*   - без верификации (NVERIFY) новые ячейки не заполняются, POISON пишется только в ячейки, освобожденные при удалении.
+*/
+
+static void stack_gap_fill_poison(stack *const stk, const size_t from)
 {
     LOG_ASSERT(stk       != nullptr);
     LOG_ASSERT(stk->data != nullptr);
+    LOG_ASSERT(from <= stk->capacity);
+
+#ifndef STACK_NVERIFY
+    stack_range_fill_poison(stk, from, stk->capacity);
+#else
+    (void) from;
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Заполняет ячейки [from, to) POISON-элементом.
+*   Первая ячейка копируется из el_poison, дальше заполненный префикс копируется сам в себя с удвоением,
+*   так что диапазон заполняется за O(log) вызовов memcpy.
+*/
+static void stack_range_fill_poison(stack *const stk, const size_t from, const size_t to)
+{
+    LOG_ASSERT(stk       != nullptr);
+    LOG_ASSERT(stk->data != nullptr);
+    LOG_ASSERT(from <= to);
+    LOG_ASSERT(to   <= stk->capacity);
 
     if (stk->el_poison == nullptr) return;
     if (stk->el_poison == STK_POISON.el_poison) return;
+    if (from == to) return;
 
-   for (size_t i = stk->size; i < stk->capacity; ++i) { stack_el_fill_poison(stk, i); }
+    char *const  begin = (char *) stack_get(stk, from);
+    const size_t total = (to - from) * stk->el_size;
+
+    memcpy(begin, stk->el_poison, stk->el_size);
+
+    for (size_t filled = stk->el_size; filled < total; filled *= 2)
+    {
+        memcpy(begin + filled, begin, (filled < total - filled) ? filled : total - filled);
+    }
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -41,11 +79,27 @@ static bool stack_gap_is_poison(const stack *const stk)
     if (stk->el_poison == nullptr) return true;
     if (stk->el_poison == STK_POISON.el_poison) return true;
 
-    for (size_t i = stk->size; i < stk->capacity; ++i)
-        if (!stack_el_is_poison(stk, i))
+#ifdef STACK_NVERIFY
+    return true;
+#else
+    const size_t gap = stk->capacity - stk->size;
+
+#ifndef STACK_NDEBUG
+    const size_t samples = gap;
+#else
+    const size_t samples = (gap < STK_GAP_SAMPLES) ? gap : STK_GAP_SAMPLES;
+#endif
+
+    for (size_t sample = 0; sample < samples; ++sample)
+    {
+        size_t check_index = (samples == gap) ? stk->size + sample
+                                              : stk->size + sample * (gap - 1) / (samples - 1);
+        if (!stack_el_is_poison(stk, check_index))
             return false;
+    }
 
     return true;
+#endif
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -59,7 +113,7 @@ static bool stack_el_is_poison(const stack *const stk, const size_t check_index)
     LOG_ASSERT(stk->el_poison !=              nullptr);
     LOG_ASSERT(stk->el_poison != STK_POISON.el_poison);
 
-    return strncmp((const char *) stack_get(stk, check_index), (const char *) stk->el_poison, stk->el_size) == 0;
+    return memcmp(stack_get(stk, check_index), stk->el_poison, stk->el_size) == 0;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -127,6 +181,11 @@ static unsigned stack_fields_verify(const stack *const stk)
     poison_verify(el_size  , STK_POISON_EL_SIZE)
     poison_verify(size     , STK_POISON_SIZE)
     poison_verify(capacity , STK_POISON_CAPACITY)
+    poison_verify(min_capacity   , STK_POISON_MIN_CAPACITY)
+    poison_verify(growth.grow_num, STK_POISON_GROWTH)
+    poison_verify(inline_data    , STK_POISON_INLINE_DATA)
+    poison_verify(inline_capacity, STK_POISON_INLINE_CAPACITY)
+    poison_verify(alc            , STK_POISON_ALC)
     poison_verify(el_poison, STK_POISON_EL_POISON)
     poison_verify(el_dtor  , STK_POISON_EL_DTOR)
     poison_verify(el_dump  , STK_POISON_EL_DUMP)
@@ -137,39 +196,83 @@ static unsigned stack_fields_verify(const stack *const stk)
 
     if (stk->data == nullptr)      err |= (1 << STK_NULLPTR_DATA);
     if (stk->size > stk->capacity) err |= (1 << STK_INVALID_SIZE_CAPACITY);
+    if (stk->min_capacity == 0)    err |= (1 << STK_INVALID_MIN_CAPACITY);
+
+    if (!stack_growth_is_valid(&stk->growth)) err |= (1 << STK_INVALID_GROWTH);
+
+    if (stk->inline_data != nullptr)
+    {
+        if (stk->capacity < stk->inline_capacity)                                   err |= (1 << STK_INVALID_INLINE_CAPACITY);
+        if (stk->data == stk->inline_data && stk->capacity != stk->inline_capacity) err |= (1 << STK_INVALID_INLINE_CAPACITY);
+    }
 
     return err;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
+bool stack_growth_is_valid(const stack_growth *const growth)
+{
+    LOG_VERIFY(growth != nullptr, false);
+
+    if (growth->grow_den == 0)                                                  return false;
+    if (growth->grow_num <  growth->grow_den)                                   return false;
+    if (growth->grow_num == growth->grow_den && growth->grow_chunk == 0)        return false;
+
+    if (growth->shrink_ratio == 0) return true;
+
+    return growth->shrink_slack > 0 && growth->shrink_slack < growth->shrink_ratio;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
 bool stack_ctor(stack *const stk, const size_t el_size, const void *const el_poison                     /* = nullptr */,
                                                               void (     *el_dtor  )(      void *const) /* = nullptr */,
                                                               void (     *el_dump  )(const void *const) /* = nullptr */,
 
-                                                              const size_t stack_capacity /* = DEFAULT_STACK_CAPACITY */)
+                                                              const size_t stack_capacity /* = DEFAULT_STACK_CAPACITY */,
+                                                              allocator   *alc            /* = nullptr */)
 {
     LOG_VERIFY(stk != nullptr      , false);
     LOG_VERIFY(el_size        > 0UL, false);
     LOG_VERIFY(stack_capacity > 0UL, false);
 
-    stk->el_size   = el_size;
-    stk->size      = 0;
-    stk->capacity  = stack_capacity;
-
-    stk->el_poison = el_poison;
-    stk->el_dtor   = el_dtor;
-    stk->el_dump   = el_dump;
+    stack_fields_ctor(stk, el_size, stack_capacity, el_poison, el_dtor, el_dump, alc);
 
-    stk->data      = LOG_CALLOC(el_size, stack_capacity);
+    stk->data      = allocator_calloc(alc, el_size, stack_capacity);
     if (stk->data == nullptr)
     {
-        LOG_ERROR("log_calloc(el_size = %lu, stack_capacity = %lu) returns nullptr\n",
+        LOG_ERROR("allocator_calloc(el_size = %lu, stack_capacity = %lu) returns nullptr\n",
                               el_size      , stack_capacity);
         return false;
     }
 
-    stack_gap_fill_poison(stk);
+    stack_gap_fill_poison(stk, 0);
+    STACK_ASSERT(stk);
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool stack_ctor_inline(stack *const stk, const size_t el_size, void *const buffer, const size_t buffer_capacity,
+                                                                     const void *const el_poison                     /* = nullptr */,
+                                                                     void (     *el_dtor  )(      void *const) /* = nullptr */,
+                                                                     void (     *el_dump  )(const void *const) /* = nullptr */,
+                                                                     allocator   *alc                              /* = nullptr */)
+{
+    LOG_VERIFY(stk    != nullptr    , false);
+    LOG_VERIFY(buffer != nullptr    , false);
+    LOG_VERIFY(el_size         > 0UL, false);
+    LOG_VERIFY(buffer_capacity > 0UL, false);
+
+    stack_fields_ctor(stk, el_size, buffer_capacity, el_poison, el_dtor, el_dump, alc);
+
+    stk->data            = buffer;
+    stk->inline_data     = buffer;
+    stk->inline_capacity = buffer_capacity;
+
+    stack_gap_fill_poison(stk, 0);
     STACK_ASSERT(stk);
 
     return true;
@@ -177,11 +280,39 @@ bool stack_ctor(stack *const stk, const size_t el_size, const void *const el_poi
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
+static void stack_fields_ctor(stack *const stk, const size_t el_size, const size_t capacity, const void *const el_poison,
+                                                                                             void (*el_dtor)(      void *const),
+                                                                                             void (*el_dump)(const void *const),
+                                                                                             allocator *alc)
+{
+    LOG_ASSERT(stk != nullptr);
+
+    stk->data      = nullptr;
+    stk->el_size   = el_size;
+    stk->size      = 0;
+    stk->capacity  = capacity;
+
+    stk->min_capacity = DEFAULT_STACK_CAPACITY;
+    stk->growth       = DEFAULT_STACK_GROWTH;
+
+    stk->inline_data     = nullptr;
+    stk->inline_capacity = 0;
+
+    stk->alc = alc;
+
+    stk->el_poison = el_poison;
+    stk->el_dtor   = el_dtor;
+    stk->el_dump   = el_dump;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
 stack *stack_new(const size_t el_size, const void *const el_poison                     /* = nullptr */,
                                              void (     *el_dtor  )(      void *const) /* = nullptr */,
                                              void (     *el_dump  )(const void *const) /* = nullptr */,
 
-                                             const size_t stack_capacity /* = DEFAULT_STACK_CAPACITY */)
+                                             const size_t stack_capacity /* = DEFAULT_STACK_CAPACITY */,
+                                             allocator   *alc            /* = nullptr */)
 {
     stack *stk = (stack *) LOG_CALLOC(1, sizeof(stack));
     if (stk == nullptr)
@@ -189,7 +320,7 @@ stack *stack_new(const size_t el_size, const void *const el_poison
         LOG_ERROR("log_calloc(1, sizeof(stack) = %lu) returns nullptr\n", sizeof(stack));
         return nullptr;
     }
-    if (!stack_ctor(stk, el_size, el_poison, el_dtor, el_dump, stack_capacity))
+    if (!stack_ctor(stk, el_size, el_poison, el_dtor, el_dump, stack_capacity, alc))
     {
         LOG_FREE(stk);
         return nullptr;
@@ -231,7 +362,7 @@ static void stack_data_dtor(stack *const stk)
         for (size_t i = 0; i < stk->size; ++i) stk->el_dtor(stack_get(stk, i));
     }
 
-    LOG_FREE(stk->data);
+    if (stk->data != stk->inline_data) allocator_free(stk->alc, stk->data, stk->capacity * stk->el_size);
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -243,7 +374,7 @@ bool stack_push(stack *const stk, const void *const data)
 
     if (stk->size == stk->capacity)
     {
-        if (stack_resize(stk, 2 * stk->capacity) == false)
+        if (stack_resize(stk, stack_grow_capacity(stk, stk->size + 1)) == false)
             return false;
     }
 
@@ -267,39 +398,222 @@ bool stack_pop(stack *const stk, void *const data /* = nullptr */)
     if (stk->el_dtor   != nullptr) stk->el_dtor(stack_get(stk, stk->size));
     if (stk->el_poison != nullptr) stack_el_fill_poison(stk, stk->size);
 
-    if (4 * stk->size <= stk->capacity)
+    stack_shrink_if_sparse(stk);
+
+    STACK_ASSERT(stk);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool stack_push_n(stack *const stk, const void *const src, const size_t n)
+{
+    STACK_VERIFY(stk, false);
+    LOG_VERIFY  (src != nullptr || n == 0, false);
+
+    if (n == 0) return true;
+
+    const char *src_data = (const char *) src;
+
+    if (stk->size + n > stk->capacity)
     {
-        size_t new_capacity = 2 * stk->size;
-        new_capacity = (new_capacity < DEFAULT_STACK_CAPACITY) ? DEFAULT_STACK_CAPACITY : new_capacity;
+        const char *old_data  = (const char *) stk->data;
+        const bool  is_inside = old_data <= src_data && src_data < old_data + stk->capacity * stk->el_size;
 
-        stack_resize(stk, new_capacity);
+        if (stack_resize(stk, stack_grow_capacity(stk, stk->size + n)) == false)
+            return false;
+
+        if (is_inside) src_data = (const char *) stk->data + (src_data - old_data);
     }
 
+    memcpy(stack_get(stk, stk->size), src_data, n * stk->el_size);
+    stk->size += n;
+
+    STACK_ASSERT(stk);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool stack_pop_n(stack *const stk, const size_t n, void *const dst /* = nullptr */)
+{
+    STACK_VERIFY(stk, false);
+    LOG_VERIFY  (n <= stk->size, false);
+
+    if (n == 0) return true;
+
+    const size_t new_size = stk->size - n;
+
+    if (dst != nullptr) memcpy(dst, stack_get(stk, new_size), n * stk->el_size);
+
+    if (stk->el_dtor != nullptr)
+    {
+        for (size_t i = new_size; i < stk->size; ++i) stk->el_dtor(stack_get(stk, i));
+    }
+    stk->size = new_size;
+
+    stack_range_fill_poison(stk, new_size, new_size + n);
+
+    stack_shrink_if_sparse(stk);
+
+    STACK_ASSERT(stk);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+size_t stack_growth_grow(const stack_growth *const growth, const size_t capacity, const size_t min_capacity)
+{
+    LOG_VERIFY(growth != nullptr, min_capacity);
+
+    size_t new_capacity = capacity;
+
+    while (new_capacity < min_capacity)
+    {
+        if (new_capacity > (SIZE_MAX - growth->grow_chunk) / growth->grow_num) return min_capacity;
+
+        // каждый шаг строго больше предыдущего: при множителе меньше 1.5 и grow_chunk = 0 малая емкость иначе не растет
+        const size_t next_capacity = new_capacity * growth->grow_num / growth->grow_den + growth->grow_chunk;
+        new_capacity = (next_capacity > new_capacity) ? next_capacity : new_capacity + 1;
+    }
+
+    return new_capacity;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+size_t stack_growth_shrink(const stack_growth *const growth, const size_t size, const size_t capacity, const size_t min_capacity)
+{
+    LOG_VERIFY(growth != nullptr, capacity);
+
+    if (growth->shrink_ratio == 0)                  return capacity;
+    if (size > capacity / growth->shrink_ratio)     return capacity;
+
+    size_t new_capacity = size * growth->shrink_slack;
+    new_capacity = (new_capacity < min_capacity) ? min_capacity : new_capacity;
+
+    return (new_capacity < capacity) ? new_capacity : capacity;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static size_t stack_grow_capacity(const stack *const stk, const size_t min_capacity)
+{
+    STACK_ASSERT(stk);
+    return stack_growth_grow(&stk->growth, stk->capacity, min_capacity);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static bool stack_shrink_if_sparse(stack *const stk)
+{
+    STACK_ASSERT(stk);
+    return stack_resize(stk, stack_growth_shrink(&stk->growth, stk->size, stk->capacity, stk->min_capacity));
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool stack_set_growth(stack *const stk, const stack_growth *const growth)
+{
+    STACK_VERIFY(stk, false);
+    LOG_VERIFY  (growth != nullptr              , false);
+    LOG_VERIFY  (stack_growth_is_valid(growth), false);
+
+    stk->growth = *growth;
+
     STACK_ASSERT(stk);
     return true;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 
-static bool stack_resize(stack *const stk, const size_t new_capacity)
+bool stack_reserve(stack *const stk, const size_t capacity)
+{
+    STACK_VERIFY(stk, false);
+
+    if (capacity > stk->min_capacity) stk->min_capacity = capacity;
+    if (capacity > stk->capacity) return stack_resize(stk, capacity);
+
+    STACK_ASSERT(stk);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool stack_shrink_to_fit(stack *const stk)
+{
+    STACK_VERIFY(stk, false);
+
+    stk->min_capacity = DEFAULT_STACK_CAPACITY;
+
+    return stack_resize(stk, (stk->size > 0) ? stk->size : 1);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+static bool stack_resize(stack *const stk, size_t new_capacity)
 {
     STACK_ASSERT(stk);
 
+    if (stk->inline_data != nullptr && new_capacity <= stk->inline_capacity)
+        new_capacity = stk->inline_capacity;
+
     if (new_capacity == stk->capacity)
         return true;
 
+    if (stk->inline_data != nullptr && (stk->data == stk->inline_data || new_capacity == stk->inline_capacity))
+        return stack_relocate(stk, new_capacity);
+
     void *old_data = stk->data;
-    stk->data = LOG_RECALLOC(stk->data, stk->capacity * stk->el_size, new_capacity * stk->el_size);
+    stk->data = allocator_recalloc(stk->alc, stk->data, stk->capacity * stk->el_size, new_capacity * stk->el_size);
     if (stk->data == nullptr)
     {
-        LOG_ERROR("log_recalloc(stack.data, (capacity = %lu) * (el_size = %lu), (new_capacity = %lu) * (el_size = %lu)) returns nullptr",
+        LOG_ERROR("allocator_recalloc(stack.data, (capacity = %lu) * (el_size = %lu), (new_capacity = %lu) * (el_size = %lu)) returns nullptr",
                                         stk->capacity,     stk->el_size,         new_capacity,     stk->el_size);
         stk->data = old_data;
         return false;
     }
 
+    const size_t old_capacity = stk->capacity;
+
+    stk->capacity = new_capacity;
+    if (new_capacity > old_capacity) stack_gap_fill_poison(stk, old_capacity);
+
+    STACK_ASSERT(stk);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/**
+*   @brief Переносит элементы стека из встроенного буфера в динамическую память или обратно.
+*   Во встроенный буфер элементы переносятся, только если new_capacity = inline_capacity.
+*/
+static bool stack_relocate(stack *const stk, const size_t new_capacity)
+{
+    LOG_ASSERT(stk->inline_data != nullptr);
+    LOG_ASSERT(new_capacity >= stk->inline_capacity);
+
+    void *new_data = stk->inline_data;
+    if (new_capacity != stk->inline_capacity)
+    {
+        new_data = allocator_calloc(stk->alc, new_capacity, stk->el_size);
+        if (new_data == nullptr)
+        {
+            LOG_ERROR("allocator_calloc(new_capacity = %lu, el_size = %lu) returns nullptr", new_capacity, stk->el_size);
+            return false;
+        }
+    }
+
+    const size_t old_capacity = stk->capacity;
+    const size_t copy_count   = (old_capacity < new_capacity) ? old_capacity : new_capacity;
+
+    memcpy(new_data, stk->data, copy_count * stk->el_size);
+    if (stk->data != stk->inline_data) allocator_free(stk->alc, stk->data, old_capacity * stk->el_size);
+
+    stk->data     = new_data;
     stk->capacity = new_capacity;
-    stack_gap_fill_poison(stk);
+    if (new_capacity > old_capacity) stack_gap_fill_poison(stk, old_capacity);
 
     STACK_ASSERT(stk);
     return true;
@@ -385,6 +699,25 @@ static bool stack_public_fields_dump(const stack *const stk)
     else if (stk->capacity  <  stk->size)            { ERROR_FIELD_DUMP  ("capacity ", "%lu", stk->capacity); is_any_invalid = true; }
     else                                             { USUAL_FIELD_DUMP  ("capacity ", "%lu", stk->capacity); }
 
+    if      (stk->min_capacity == STK_POISON.min_capacity) { POISON_FIELD_DUMP("min_capacity"); is_any_invalid = true; }
+    else if (stk->min_capacity == 0)                       { ERROR_FIELD_DUMP ("min_capacity", "%lu", stk->min_capacity); is_any_invalid = true; }
+    else                                                   { USUAL_FIELD_DUMP ("min_capacity", "%lu", stk->min_capacity); }
+
+    if (stk->growth.grow_num == STK_POISON.growth.grow_num) { POISON_FIELD_DUMP("growth   "); is_any_invalid = true; }
+    else
+    {
+        const stack_growth *const growth = &stk->growth;
+
+        #define growth_dump(color)                                                                                          \
+            LOG_TAB_MESSAGE(color "growth    = {%lu / %lu + %lu, shrink: 1 / %lu -> 1 / %lu}" HTML_COLOR_CANCEL "\n",     \
+                            growth->grow_num, growth->grow_den, growth->grow_chunk, growth->shrink_ratio, growth->shrink_slack)
+
+        if (stack_growth_is_valid(growth)) { growth_dump(HTML_COLOR_BLACK); }
+        else                               { growth_dump(HTML_COLOR_DARK_RED); is_any_invalid = true; }
+
+        #undef growth_dump
+    }
+
     if      (stk->el_poison == STK_POISON.el_poison) { POISON_FIELD_DUMP ("el_poison"); is_any_invalid = true; }
     else if (stk->el_poison == nullptr)              { WARNING_FIELD_DUMP("el_poison", "%p", stk->el_poison); }
     else                                             { USUAL_FIELD_DUMP  ("el_poison", "%p", stk->el_poison); }
@@ -413,6 +746,16 @@ static bool stack_static_fields_dump(const stack *const stk)
     else if (stk->data == nullptr)         { ERROR_FIELD_DUMP ("data", "%p", nullptr); is_any_invalid = true; }
     else                                   { USUAL_FIELD_DUMP ("data", "%p", stk->data); }
 
+    if      (stk->inline_data == STK_POISON.inline_data) { POISON_FIELD_DUMP("inline_data"); is_any_invalid = true; }
+    else if (stk->inline_data != nullptr)
+    {
+        USUAL_FIELD_DUMP("inline_data    ", "%p" , stk->inline_data);
+        USUAL_FIELD_DUMP("inline_capacity", "%lu", stk->inline_capacity);
+    }
+
+    if      (stk->alc == STK_POISON.alc) { POISON_FIELD_DUMP("alc"); is_any_invalid = true; }
+    else if (stk->alc != nullptr)        { USUAL_FIELD_DUMP ("alc", "%p", stk->alc); }
+
     LOG_MESSAGE("\n");
     return is_any_invalid;
 }
@@ -483,7 +826,7 @@ static void stack_el_dump(const stack *const stk, const void *const el)
 
     if (stk->el_poison != nullptr)
     {
-        if (strncmp((const char *) stk->el_poison, (const char *) el, stk->el_size) == 0)
+        if (memcmp(stk->el_poison, el, stk->el_size) == 0)
         {
             LOG_TAB_POISON_MESSAGE("POISON", "\n");
             return;
@@ -557,20 +900,64 @@ bool vector_resize(vector *const vec, const size_t count)
 
     if (count == vec->size) return true;
 
-    vec->size = count;
-    bool result = true;
-
-    if (count > vec->capacity) result = stack_resize(vec, count);
-    else
+    if (count > vec->size)
     {
-        if (vec->el_dtor != nullptr)
-        {
-            for (size_t ind = count; ind < vec->size; ++ind)
-                vec->el_dtor(VECTOR_GET(vec, ind));
-        }
+        if (count > vec->capacity && !stack_resize(vec, stack_grow_capacity(vec, count))) return false;
+
+        memset(VECTOR_GET(vec, vec->size), 0, (count - vec->size) * vec->el_size);
+        vec->size = count;
 
-        if  (4 * count < vec->capacity) result = stack_resize(vec, count * 2);
+        VECTOR_ASSERT(vec);
+        return true;
     }
 
+    if (vec->el_dtor != nullptr)
+    {
+        for (size_t ind = count; ind < vec->size; ++ind) vec->el_dtor(VECTOR_GET(vec, ind));
+    }
+
+    stack_range_fill_poison(vec, count, vec->size);
+    vec->size = count;
+
+    bool result = stack_shrink_if_sparse(vec);
+
+    VECTOR_ASSERT(vec);
     return result;
 }
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool vector_append(vector *const vec, const vector *const other)
+{
+    VECTOR_VERIFY(vec  , false);
+    VECTOR_VERIFY(other, false);
+    LOG_VERIFY   (vec->el_size == other->el_size, false);
+
+    return stack_push_n(vec, other->data, other->size);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool vector_sort(vector *const vec, int (*el_cmp)(const void *el_1, const void *el_2))
+{
+    VECTOR_VERIFY(vec, false);
+    LOG_VERIFY   (el_cmp != nullptr, false);
+
+    bool ret = my_sort(vec->data, vec->size, vec->el_size, el_cmp);
+
+    VECTOR_ASSERT(vec);
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+bool vector_parallel_sort(vector *const vec, int (*el_cmp)(const void *el_1, const void *el_2), const size_t thread_count /* = 0 */)
+{
+    VECTOR_VERIFY(vec, false);
+    LOG_VERIFY   (el_cmp != nullptr, false);
+
+    bool ret = my_parallel_sort(vec->data, vec->size, vec->el_size, el_cmp, thread_count);
+
+    VECTOR_ASSERT(vec);
+    return ret;
+}
@@ -5,6 +5,7 @@
 #include <stdio.h>
 #include <assert.h>
 #include <string.h>
+#include <stdint.h>
 
 #define LOG_NTRACE
 
@@ -16,6 +17,11 @@
 
 const size_t DEFAULT_STACK_CAPACITY = 4;
 
+static const size_t STK_GAP_SAMPLES = 16; ///< количество проверяемых ячеек промежутка [size, capacity) в сборке без _DEBUG
+
+const stack_growth DEFAULT_STACK_GROWTH = { .grow_num = 2, .grow_den = 1, .grow_chunk = 0, .shrink_ratio = 4, .shrink_slack = 2 };
+const stack_growth STACK_GROWTH_X1_5    = { .grow_num = 3, .grow_den = 2, .grow_chunk = 0, .shrink_ratio = 4, .shrink_slack = 2 };
+
 //================================================================================================================================
 
 /**
@@ -31,12 +37,20 @@ typedef enum
     STK_POISON_EL_SIZE              , ///< .el_size   = STK_POISON.el_size
     STK_POISON_SIZE                 , ///< .size      = STK_POISON.size
     STK_POISON_CAPACITY             , ///< .capacity  = STK_POISON.capacity
+    STK_POISON_MIN_CAPACITY         , ///< .min_capacity = STK_POISON.min_capacity
+    STK_POISON_GROWTH               , ///< .growth    = STK_POISON.growth
+    STK_POISON_INLINE_DATA          , ///< .inline_data     = STK_POISON.inline_data
+    STK_POISON_INLINE_CAPACITY      , ///< .inline_capacity = STK_POISON.inline_capacity
+    STK_POISON_ALC                  , ///< .alc       = STK_POISON.alc
     STK_POISON_EL_POISON            , ///< .el_poison = STK_POISON.el_poison
     STK_POISON_EL_DTOR              , ///< .el_dtor   = STK_POISON.el_dtor
     STK_POISON_EL_DUMP              , ///< .el_dump   = STK_POISON.el_dump
 
     STK_NOT_POISON_GAP              , ///< не POISON-значение в неиспользуемой ячейке
     STK_INVALID_SIZE_CAPACITY       , ///< .size > .capacity
+    STK_INVALID_MIN_CAPACITY        , ///< .min_capacity = 0
+    STK_INVALID_GROWTH              , ///< .growth не увеличивает емкость или не дает гистерезиса
+    STK_INVALID_INLINE_CAPACITY     , ///< .capacity < .inline_capacity или .data = .inline_data при .capacity != .inline_capacity
 }
 STK_STATUS_TYPE;
 
@@ -52,15 +66,23 @@ static const char *STK_STATUS_MESSAGES[] =
     "stack.data is nullptr"                 ,
 
     "stack.data is invalid"                 ,
+    "stack.el_size is invalid"              ,
     "stack.size is invalid"                 ,
     "stack.capacity is invalid"             ,
+    "stack.min_capacity is invalid"         ,
+    "stack.growth is invalid"               ,
+    "stack.inline_data is invalid"          ,
+    "stack.inline_capacity is invalid"      ,
+    "stack.alc is invalid"                  ,
     "stack.el_poison is invalid"            ,
-    "stack.el_size is invalid"              ,
     "stack.el_dtor is invalid"              ,
     "stack.el_dump is invalid"              ,
 
     "stack gap is not poisoned"            ,
     "stack.size more than stack.capacity"  ,
+    "stack.min_capacity is zero"           ,
+    "stack.growth is inconsistent"         ,
+    "stack.capacity doesn't match inline buffer",
 };
 
 static const stack STK_POISON =
@@ -71,6 +93,14 @@ static const stack STK_POISON =
     .size     = 0xBADCAB1E,
     .capacity = 0xDEADBEFF,
 
+    .min_capacity = 0xFACEB00C,
+    .growth       = { .grow_num = 0xD15EA5E, .grow_den = 0xDECAF, .grow_chunk = 0xC0FFEE, .shrink_ratio = 0xBAADF00D, .shrink_slack = 0xCAFEBABE },
+
+    .inline_data     = (void *) 0xFEE1DEAD,
+    .inline_capacity = 0xDEADC0DE,
+
+    .alc = (allocator *) 0xDEFEC8ED,
+
     .el_poison = (const void *) 0xCAFED00D,
 
     .el_dtor = (void (*)(      void *const)) 0xFEEDFACE,
@@ -79,7 +109,8 @@ static const stack STK_POISON =
 
 //================================================================================================================================
 
-static void     stack_gap_fill_poison   (stack *const stk);
+static void     stack_gap_fill_poison   (stack *const stk, const size_t from);
+static void     stack_range_fill_poison (stack *const stk, const size_t from, const size_t to);
 static void     stack_el_fill_poison    (stack *const stk, const size_t filled_index);
 
 static bool     stack_gap_is_poison     (const stack *const stk);
@@ -90,8 +121,16 @@ static void    *stack_get               (const stack *const stk, const size_t in
 static void     stack_log_error         (const stack *const stk, const unsigned err);
 static unsigned stack_fields_verify     (const stack *const stk);
 
+static void     stack_fields_ctor       (stack *const stk, const size_t el_size, const size_t capacity, const void *const el_poison,
+                                                                                                  void (*el_dtor)(      void *const),
+                                                                                                  void (*el_dump)(const void *const),
+                                                                                                  allocator *alc);
 static void     stack_data_dtor         (stack *const stk);
-static bool     stack_resize            (stack *const stk, const size_t new_capacity);
+static bool     stack_resize            (stack *const stk, size_t new_capacity);
+static bool     stack_relocate          (stack *const stk, const size_t new_capacity);
+
+static size_t   stack_grow_capacity     (const stack *const stk, const size_t min_capacity);
+static bool     stack_shrink_if_sparse  (stack *const stk);
 
 static void     stack_static_dump       (const stack *const stk, const bool is_full);
 static bool     stack_header_dump       (const stack *const stk);
@@ -3,6 +3,7 @@
 #define VECTOR_STATIC_H
 
 #include "vector.h"
+#include "algorithm.h"
 
 //================================================================================================================================
 